@@ -88,7 +88,6 @@ Modifications by mioty Alliance e.V. (2025)
 #include "hardware/spi.h"
 #include "hardware/gpio.h"
 #include "pico/time.h"
-#include <memory>
 #include <cstring>
 
 using namespace TsUnbLib::RPPico;
@@ -97,7 +96,6 @@ TSUNBDriver::TSUNBDriver()
     : m_initialized(false)
     , m_last_error(TSUNBStatus::ERROR_NOT_INITIALIZED)
     , m_transmitting(false)
-    , m_active_node(nullptr)
 {
 }
 
@@ -105,82 +103,22 @@ TSUNBDriver::~TSUNBDriver() {
     if (m_initialized) {
         m_initialized = false;
     }
-    
-    if (m_active_node) {
-        // Clean up the node based on the configuration type
-        if (m_config.region == TSUNBDriver::Region::EU0) {
-            if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-                delete static_cast<TsUnb_EU0_Rfm69w_t*>(m_active_node);
-            } else {
-                delete static_cast<TsUnb_EU0_Rfm69hw_t*>(m_active_node);
-            }
-        } else if (m_config.region == TSUNBDriver::Region::EU1) {
-            if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-                delete static_cast<TsUnb_EU1_Rfm69w_t*>(m_active_node);
-            } else {
-                delete static_cast<TsUnb_EU1_Rfm69hw_t*>(m_active_node);
-            }
-        } else if (m_config.region == TSUNBDriver::Region::EU2) {
-            if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-                delete static_cast<TsUnb_EU2_Rfm69w_t*>(m_active_node);
-            } else {
-                delete static_cast<TsUnb_EU2_Rfm69hw_t*>(m_active_node);
-            }
-        } else if (m_config.region == TSUNBDriver::Region::US0) {
-            if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-                delete static_cast<TsUnb_US0_Rfm69w_t*>(m_active_node);
-            } else {
-                delete static_cast<TsUnb_US0_Rfm69hw_t*>(m_active_node);
-            }
-        }
-        m_active_node = nullptr;
-    }
 }
 
 TSUNBStatus TSUNBDriver::initialize(const NodeConfig& config) {
     Logger::info("Initializing TS-UNB driver (Third-Party Modified Version of the Fraunhofer TS-UNB-Lib)...");
     
-    m_config = config;
-    
-    // Create the appropriate node instance based on region and chip type
-    if (config.region == TSUNBDriver::Region::EU0) {
-        if (config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            m_active_node = new TsUnb_EU0_Rfm69w_t();
-        } else {
-            m_active_node = new TsUnb_EU0_Rfm69hw_t();
-        }
-    } else if (config.region == TSUNBDriver::Region::EU1) {
-        if (config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            m_active_node = new TsUnb_EU1_Rfm69w_t();
-        } else {
-            m_active_node = new TsUnb_EU1_Rfm69hw_t();
-        }
-    } else if (config.region == TSUNBDriver::Region::EU2) {
-        if (config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            m_active_node = new TsUnb_EU2_Rfm69w_t();
-        } else {
-            m_active_node = new TsUnb_EU2_Rfm69hw_t();
-        }
-    } else if (config.region == TSUNBDriver::Region::US0) {
-        if (config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            m_active_node = new TsUnb_US0_Rfm69w_t();
-        } else {
-            m_active_node = new TsUnb_US0_Rfm69hw_t();
-        }
-    } else {
-        Logger::error("Unsupported region configuration");
+    // The node type is fixed at compile time by app_config.hpp
+    if (config.region != Config::Mioty::REGION || config.chip_type != Config::Mioty::CHIP_TYPE) {
+        Logger::error("Region or chip type differs from the compiled node type (Config::Mioty)");
         m_last_error = TSUNBStatus::ERROR_INVALID_PARAMETER;
         return m_last_error;
     }
     
-    if (!m_active_node) {
-        Logger::error("Failed to create TS-UNB node instance");
-        m_last_error = TSUNBStatus::ERROR_HARDWARE_FAULT;
-        return m_last_error;
-    }
+    m_config = config;
     
     // Initialize the node
-    configureActiveNode();
+    configureNode();
     
     m_initialized = true;
     m_last_error = TSUNBStatus::OK;
@@ -194,11 +132,11 @@ bool TSUNBDriver::isInitialized() const {
 }
 
 TSUNBStatus TSUNBDriver::sendData(const uint8_t* data, size_t length) {
-    if (!m_initialized || !m_active_node) {
+    if (!m_initialized) {
         return TSUNBStatus::ERROR_NOT_INITIALIZED;
     }
     
-    if (length == 0 || !data) {
+    if (length == 0 || length > MAX_PAYLOAD_LENGTH || !data) {
         return TSUNBStatus::ERROR_INVALID_PARAMETER;
     }
     
@@ -206,38 +144,54 @@ TSUNBStatus TSUNBDriver::sendData(const uint8_t* data, size_t length) {
         return TSUNBStatus::ERROR_BUFFER_FULL;
     }
     
-    Logger::debug("Sending %d bytes via TS-UNB", length);
+    // Single copy into the payload region, the MAC encodes it in place
+    memmove(getPayloadBuffer(), data, length);
+    return sendPayload(length);
+}
+
+uint8_t* TSUNBDriver::getPayloadBuffer() {
+    return &m_frame[TsUnbLib::TsUnb::FixedUplinkMac::HEADROOM];
+}
+
+TSUNBStatus TSUNBDriver::sendPayload(size_t length) {
+    if (!m_initialized) {
+        return TSUNBStatus::ERROR_NOT_INITIALIZED;
+    }
     
-    m_transmitting = true;
+    if (length == 0 || length > MAX_PAYLOAD_LENGTH) {
+        return TSUNBStatus::ERROR_INVALID_PARAMETER;
+    }
     
-    // Call the appropriate send method based on the active node type
-    if (m_config.region == TSUNBDriver::Region::EU0) {
-        if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            static_cast<TsUnb_EU0_Rfm69w_t*>(m_active_node)->send(const_cast<uint8_t*>(data), length);
-        } else {
-            static_cast<TsUnb_EU0_Rfm69hw_t*>(m_active_node)->send(const_cast<uint8_t*>(data), length);
-        }
-    } else if (m_config.region == TSUNBDriver::Region::EU1) {
-        if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            static_cast<TsUnb_EU1_Rfm69w_t*>(m_active_node)->send(const_cast<uint8_t*>(data), length);
-        } else {
-            static_cast<TsUnb_EU1_Rfm69hw_t*>(m_active_node)->send(const_cast<uint8_t*>(data), length);
-        }
-    } else if (m_config.region == TSUNBDriver::Region::EU2) {
-        if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            static_cast<TsUnb_EU2_Rfm69w_t*>(m_active_node)->send(const_cast<uint8_t*>(data), length);
-        } else {
-            static_cast<TsUnb_EU2_Rfm69hw_t*>(m_active_node)->send(const_cast<uint8_t*>(data), length);
-        }
-    } else if (m_config.region == TSUNBDriver::Region::US0) {
-        if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            static_cast<TsUnb_US0_Rfm69w_t*>(m_active_node)->send(const_cast<uint8_t*>(data), length);
-        } else {
-            static_cast<TsUnb_US0_Rfm69hw_t*>(m_active_node)->send(const_cast<uint8_t*>(data), length);
-        }
+    if (m_transmitting) {
+        return TSUNBStatus::ERROR_BUFFER_FULL;
     }
     
+    Logger::debug("Sending %d bytes via TS-UNB (in place)", length);
+    
+    m_transmitting = true;
+    
+    // Transmit the payload in the MPDU buffer, which is encoded in place, and precompute
+    // the encryption of the next packet while idle
+    const int16_t result = m_node.sendInPlace(m_frame, length);
+    m_node.prepareNextFrame();
+    
+#ifdef TSUNB_TIMING_STATS
+    // Jitter of the burst starts: delay between symbol timer interrupt and the return of waitTimer()
+    Logger::info("TS-UNB timer wake-up latency: min %lu us, max %lu us, %lu timer interrupts",
+                 (unsigned long)TsUnbWakeLatencyMin_us, (unsigned long)TsUnbWakeLatencyMax_us,
+                 (unsigned long)TsUnbTimerInterrupts);
+    // CPU time of the waits between the bursts: sleeping in __wfe() versus spinning on the timer flag
+    Logger::info("TS-UNB timer wait: %lu us sleeping, %lu us spinning, %lu wake-ups",
+                 (unsigned long)TsUnbWaitSleep_us, (unsigned long)TsUnbWaitSpin_us,
+                 (unsigned long)TsUnbWaitWakeUps);
+#endif
+    
     m_transmitting = false;
+    if (result < 0) {
+        Logger::error("TS-UNB transmission of %d bytes failed (%d)", length, result);
+        m_last_error = TSUNBStatus::ERROR_COMMUNICATION;
+        return m_last_error;
+    }
     m_last_error = TSUNBStatus::OK;
     
     return TSUNBStatus::OK;
@@ -268,9 +222,9 @@ int TSUNBDriver::getRSSI() const {
 TSUNBStatus TSUNBDriver::reset() {
     Logger::debug("Resetting TS-UNB module");
     
-    if (m_active_node) {
+    if (m_initialized) {
         // Reinitialize the node
-        configureActiveNode();
+        configureNode();
     }
     
     m_last_error = TSUNBStatus::OK;
@@ -281,124 +235,30 @@ TSUNBStatus TSUNBDriver::getLastError() const {
     return m_last_error;
 }
 
-void* TSUNBDriver::getActiveNode() {
-    return m_active_node;
-}
-
-void TSUNBDriver::configureActiveNode() {
-    if (!m_active_node) return;
-    
+void TSUNBDriver::configureNode() {
     Logger::debug("Configuring TS-UNB node...");
     
-    // Configure the node based on type - this is a template for the configuration
-    // The actual implementation depends on the TS-UNB-Lib API
-    
-    // Initialize the node
-    if (m_config.region == TSUNBDriver::Region::EU0) {
-        if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            auto* node = static_cast<TsUnb_EU0_Rfm69w_t*>(m_active_node);
-            node->init();
-            node->Tx.setTxPower(m_config.tx_power_dbm);
-            node->Mac.setNetworkKey(m_config.network_key[0], m_config.network_key[1], m_config.network_key[2], 
-                                   m_config.network_key[3], m_config.network_key[4], m_config.network_key[5], 
-                                   m_config.network_key[6], m_config.network_key[7], m_config.network_key[8], 
-                                   m_config.network_key[9], m_config.network_key[10], m_config.network_key[11], 
-                                   m_config.network_key[12], m_config.network_key[13], m_config.network_key[14], 
-                                   m_config.network_key[15]);
-            node->Mac.setEui64(m_config.eui64[0], m_config.eui64[1], m_config.eui64[2], m_config.eui64[3], 
-                               m_config.eui64[4], m_config.eui64[5], m_config.eui64[6], m_config.eui64[7]);
-            node->Mac.setShortAddress(m_config.short_addr[0], m_config.short_addr[1]);
-            node->Mac.extPkgCnt = m_config.ext_pkg_cnt;
-        } else {
-            auto* node = static_cast<TsUnb_EU0_Rfm69hw_t*>(m_active_node);
-            node->init();
-            node->Tx.setTxPower(m_config.tx_power_dbm);
-            node->Mac.setNetworkKey(m_config.network_key[0], m_config.network_key[1], m_config.network_key[2], 
-                                   m_config.network_key[3], m_config.network_key[4], m_config.network_key[5], 
-                                   m_config.network_key[6], m_config.network_key[7], m_config.network_key[8], 
-                                   m_config.network_key[9], m_config.network_key[10], m_config.network_key[11], 
-                                   m_config.network_key[12], m_config.network_key[13], m_config.network_key[14], 
-                                   m_config.network_key[15]);
-            node->Mac.setEui64(m_config.eui64[0], m_config.eui64[1], m_config.eui64[2], m_config.eui64[3], 
-                               m_config.eui64[4], m_config.eui64[5], m_config.eui64[6], m_config.eui64[7]);
-            node->Mac.setShortAddress(m_config.short_addr[0], m_config.short_addr[1]);
-            node->Mac.extPkgCnt = m_config.ext_pkg_cnt;
-        }
-    } 
-    // Similar configuration for other regions would go here...
-    // For now, let's implement EU1 which is most commonly used
-    else if (m_config.region == TSUNBDriver::Region::EU1) {
-        if (m_config.chip_type == TSUNBDriver::ChipType::RFM69W) {
-            auto* node = static_cast<TsUnb_EU1_Rfm69w_t*>(m_active_node);
-            node->init();
-            node->Tx.setTxPower(m_config.tx_power_dbm);
-            node->Mac.setNetworkKey(m_config.network_key[0], m_config.network_key[1], m_config.network_key[2], 
-                                   m_config.network_key[3], m_config.network_key[4], m_config.network_key[5], 
-                                   m_config.network_key[6], m_config.network_key[7], m_config.network_key[8], 
-                                   m_config.network_key[9], m_config.network_key[10], m_config.network_key[11], 
-                                   m_config.network_key[12], m_config.network_key[13], m_config.network_key[14], 
-                                   m_config.network_key[15]);
-            node->Mac.setEui64(m_config.eui64[0], m_config.eui64[1], m_config.eui64[2], m_config.eui64[3], 
-                               m_config.eui64[4], m_config.eui64[5], m_config.eui64[6], m_config.eui64[7]);
-            node->Mac.setShortAddress(m_config.short_addr[0], m_config.short_addr[1]);
-            node->Mac.extPkgCnt = m_config.ext_pkg_cnt;
-        } else {
-            auto* node = static_cast<TsUnb_EU1_Rfm69hw_t*>(m_active_node);
-            node->init();
-            node->Tx.setTxPower(m_config.tx_power_dbm);
-            node->Mac.setNetworkKey(m_config.network_key[0], m_config.network_key[1], m_config.network_key[2], 
-                                   m_config.network_key[3], m_config.network_key[4], m_config.network_key[5], 
-                                   m_config.network_key[6], m_config.network_key[7], m_config.network_key[8], 
-                                   m_config.network_key[9], m_config.network_key[10], m_config.network_key[11], 
-                                   m_config.network_key[12], m_config.network_key[13], m_config.network_key[14], 
-                                   m_config.network_key[15]);
-            node->Mac.setEui64(m_config.eui64[0], m_config.eui64[1], m_config.eui64[2], m_config.eui64[3], 
-                               m_config.eui64[4], m_config.eui64[5], m_config.eui64[6], m_config.eui64[7]);
-            node->Mac.setShortAddress(m_config.short_addr[0], m_config.short_addr[1]);
-            node->Mac.extPkgCnt = m_config.ext_pkg_cnt;
-        }
-    }
-    // Add other regions as needed...
+    m_node.init();
+    m_node.Tx.setTxPower(m_config.tx_power_dbm);
+    m_node.Mac.setNetworkKey(m_config.network_key[0], m_config.network_key[1], m_config.network_key[2], 
+                             m_config.network_key[3], m_config.network_key[4], m_config.network_key[5], 
+                             m_config.network_key[6], m_config.network_key[7], m_config.network_key[8], 
+                             m_config.network_key[9], m_config.network_key[10], m_config.network_key[11], 
+                             m_config.network_key[12], m_config.network_key[13], m_config.network_key[14], 
+                             m_config.network_key[15]);
+    m_node.Mac.setEui64(m_config.eui64[0], m_config.eui64[1], m_config.eui64[2], m_config.eui64[3], 
+                        m_config.eui64[4], m_config.eui64[5], m_config.eui64[6], m_config.eui64[7]);
+    m_node.Mac.setShortAddress(m_config.short_addr[0], m_config.short_addr[1]);
+    m_node.Mac.extPkgCnt = m_config.ext_pkg_cnt;
+    m_node.prepareNextFrame();
     
     Logger::debug("TS-UNB node configured successfully");
 }
 
 uint32_t TSUNBDriver::getFrameCounter() const {
-    if (!m_initialized || !m_active_node) {
+    if (!m_initialized) {
         return 0;
     }
     
-    // Access the frame counter from the active node
-    if (m_config.region == Region::EU0) {
-        auto* node = static_cast<TsUnb_EU0_Rfm69w_t*>(m_active_node);
-        return node->Mac.extPkgCnt;
-    } else if (m_config.region == Region::EU1) {
-        auto* node = static_cast<TsUnb_EU1_Rfm69w_t*>(m_active_node);
-        return node->Mac.extPkgCnt;
-    } else if (m_config.region == Region::EU2) {
-        auto* node = static_cast<TsUnb_EU2_Rfm69w_t*>(m_active_node);
-        return node->Mac.extPkgCnt;
-    } else if (m_config.region == Region::US0) {
-        auto* node = static_cast<TsUnb_US0_Rfm69w_t*>(m_active_node);
-        return node->Mac.extPkgCnt;
-    }
-    
-    // Handle RFM69HW variants
-    if (m_config.chip_type == ChipType::RFM69HW) {
-        if (m_config.region == Region::EU0) {
-            auto* node = static_cast<TsUnb_EU0_Rfm69hw_t*>(m_active_node);
-            return node->Mac.extPkgCnt;
-        } else if (m_config.region == Region::EU1) {
-            auto* node = static_cast<TsUnb_EU1_Rfm69hw_t*>(m_active_node);
-            return node->Mac.extPkgCnt;
-        } else if (m_config.region == Region::EU2) {
-            auto* node = static_cast<TsUnb_EU2_Rfm69hw_t*>(m_active_node);
-            return node->Mac.extPkgCnt;
-        } else if (m_config.region == Region::US0) {
-            auto* node = static_cast<TsUnb_US0_Rfm69hw_t*>(m_active_node);
-            return node->Mac.extPkgCnt;
-        }
-    }
-    
-    return 0;
+    return m_node.Mac.extPkgCnt;
 }
@@ -93,6 +93,8 @@ Modifications by mioty Alliance e.V. (2025)
 
 // Include TS-UNB library wrapper to get access to all node types
 #include "ts_unb_lib_wrapper.h"
+#include "ts_unb_types.hpp"
+#include "../../src/config/app_config.hpp"
 
 /**
  * @brief TS-UNB communication status
@@ -118,33 +120,53 @@ struct TSUNBMessage {
     TSUNBMessage() : timestamp(0), message_id(0) {}
 };
 
+/**
+ * @brief Node type of a region and radio chip
+ */
+template <TSUNBRegion REGION, TSUNBChipType CHIP_TYPE>
+struct TSUNBNodeSelector;
+
+template <> struct TSUNBNodeSelector<TSUNBRegion::EU0, TSUNBChipType::RFM69W>  { typedef TsUnb_EU0_Rfm69w_t type; };
+template <> struct TSUNBNodeSelector<TSUNBRegion::EU0, TSUNBChipType::RFM69HW> { typedef TsUnb_EU0_Rfm69hw_t type; };
+template <> struct TSUNBNodeSelector<TSUNBRegion::EU1, TSUNBChipType::RFM69W>  { typedef TsUnb_EU1_Rfm69w_t type; };
+template <> struct TSUNBNodeSelector<TSUNBRegion::EU1, TSUNBChipType::RFM69HW> { typedef TsUnb_EU1_Rfm69hw_t type; };
+template <> struct TSUNBNodeSelector<TSUNBRegion::EU2, TSUNBChipType::RFM69W>  { typedef TsUnb_EU2_Rfm69w_t type; };
+template <> struct TSUNBNodeSelector<TSUNBRegion::EU2, TSUNBChipType::RFM69HW> { typedef TsUnb_EU2_Rfm69hw_t type; };
+template <> struct TSUNBNodeSelector<TSUNBRegion::US0, TSUNBChipType::RFM69W>  { typedef TsUnb_US0_Rfm69w_t type; };
+template <> struct TSUNBNodeSelector<TSUNBRegion::US0, TSUNBChipType::RFM69HW> { typedef TsUnb_US0_Rfm69hw_t type; };
+
 /**
  * @brief Driver for TS-UNB-Lib-Pico integration
  * This driver provides a clean interface to the Fraunhofer TS-UNB-Lib
  */
 class TSUNBDriver {
 public:
+    /**
+     * @brief Maximum payload length of sendPayload() (short addressing)
+     */
+    static constexpr size_t MAX_PAYLOAD_LENGTH = TSUNBPHY_MAX_PSDU_LENGTH - MAC_OVERHEAD_SHORT_ADDR;
+
     /**
      * @brief Node configuration regions
      */
-    enum class Region {
-        EU0,     ///< Europe 868 MHz band 0
-        EU1,     ///< Europe 868 MHz band 1  
-        EU2,     ///< Europe 868 MHz band 2
-        US0      ///< US 915 MHz band 0
-    };
+    using Region = TSUNBRegion;
     
     /**
      * @brief Radio chip types
      */
-    enum class ChipType {
-        RFM69W,   ///< RFM69W standard version
-        RFM69HW   ///< RFM69HW high-power version
-    };
+    using ChipType = TSUNBChipType;
+    
+    /**
+     * @brief Node type of the region and chip selected in app_config.hpp
+     * 
+     * Only this node type is instantiated, the driver owns it by value and calls it directly.
+     */
+    typedef TSUNBNodeSelector<Config::Mioty::REGION, Config::Mioty::CHIP_TYPE>::type Node;
     
     /**
      * @brief TS-UNB node configuration
-     * Note: Values should be populated from app_config.hpp, no defaults here
+     * Note: Values should be populated from app_config.hpp, no defaults here.
+     * Region and chip type must match Config::Mioty::REGION and Config::Mioty::CHIP_TYPE.
      */
     struct NodeConfig {
         Region region;
@@ -194,6 +216,25 @@ public:
      */
     TSUNBStatus sendMessage(const TSUNBMessage& message);
     
+    /**
+     * @brief Get the payload region of the MPDU buffer
+     * 
+     * The payload can be assembled directly in this region (MAX_PAYLOAD_LENGTH bytes),
+     * e.g. by a PayloadConfig::PayloadBuilder, and sent without copies by sendPayload().
+     * @return Pointer to the payload region
+     */
+    uint8_t* getPayloadBuffer();
+    
+    /**
+     * @brief Send the payload in the payload region of the MPDU buffer
+     * 
+     * The MAC header is written in front of the payload and the payload is encrypted
+     * in place, i.e. the payload region is overwritten.
+     * @param length Length of the payload in the payload region
+     * @return TSUNBStatus indicating success or failure
+     */
+    TSUNBStatus sendPayload(size_t length);
+    
     /**
      * @brief Check if transmission is in progress
      * @return true if transmitting, false otherwise
@@ -230,17 +271,14 @@ private:
     TSUNBStatus m_last_error;
     bool m_transmitting;
     
-    // TS-UNB node instance - using void* to work with different node types
-    void* m_active_node; ///< Pointer to the active node instance
+    Node m_node; ///< TS-UNB node instance of the configured region and chip
     
-    /**
-     * @brief Get the active node based on configuration
-     * @return Pointer to active node or nullptr
-     */
-    void* getActiveNode();
+    /// MPDU buffer: MAC headroom, payload region and CMAC tag
+    uint8_t m_frame[TsUnbLib::TsUnb::FixedUplinkMac::HEADROOM + MAX_PAYLOAD_LENGTH +
+                    TsUnbLib::TsUnb::FixedUplinkMac::TAG_LENGTH];
     
     /**
-     * @brief Configure the active node with settings
+     * @brief Configure the node with settings
      */
-    void configureActiveNode();
+    void configureNode();
 };
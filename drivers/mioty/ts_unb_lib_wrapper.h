@@ -83,6 +83,12 @@ Modifications by mioty Alliance e.V. (2025)
 
 #pragma once
 
+#include "../../src/config/payload_config.hpp"
+
+// All uplinks carry the payload defined in payload_config.hpp with short addressing,
+// so the PHY can use a precomputed interleaver table for this MPDU length
+#define TSUNB_FIXED_MPDU_LENGTH (MAC_OVERHEAD_SHORT_ADDR + PayloadConfig::Utils::calculateExpectedPayloadSize())
+
 // Include the main TS-UNB library header - this brings in all node types
 #include "../../lib/ts-unb-lib-rfm69/src/RPPicoTsUnb.h"
 
@@ -0,0 +1,31 @@
+/**
+ * @file ts_unb_types.hpp
+ * @brief Region and radio chip selection of the TS-UNB driver
+ *
+ * Kept separate from ts_unb_driver.hpp so that app_config.hpp can select the
+ * region and chip without depending on the driver, which in turn instantiates
+ * only the node type selected there.
+ *
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+/**
+ * @brief Node configuration regions
+ */
+enum class TSUNBRegion {
+    EU0,     ///< Europe 868 MHz band 0
+    EU1,     ///< Europe 868 MHz band 1
+    EU2,     ///< Europe 868 MHz band 2
+    US0      ///< US 915 MHz band 0
+};
+
+/**
+ * @brief Radio chip types
+ */
+enum class TSUNBChipType {
+    RFM69W,   ///< RFM69W standard version
+    RFM69HW   ///< RFM69HW high-power version
+};
@@ -68,6 +68,9 @@ Am Wolfsmantel 33
 91058 Erlangen, Germany
 ks-contracts@iis.fraunhofer.de
 
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
 ----------------------------------------------------------------------------- */
 
 
@@ -80,6 +83,11 @@ ks-contracts@iis.fraunhofer.de
  * This file implements the basic AES-128 encryption algorithms according to
  * the NIST standard available here: https://nvlpubs.nist.gov/nistpubs/FIPS/NIST.FIPS.197.pdf/
  *
+ * Aes128 is the byte oriented Aes128Compact by default. Defining TSUNB_AES_TTABLE
+ * (CMake option of the same name) selects the faster word oriented Aes128TTable
+ * (Aes128TTable.h) instead, which needs an additional 1.25 kB lookup table. In host
+ * builds TSUNB_AES_HOST selects Aes128Host (Aes128Host.h), i.e. AES-NI if available.
+ *
  */
 
 
@@ -151,7 +159,7 @@ uint8_t AES_sBox[256] = {
  * to support the ATmega328p.
  *
  */
-class Aes128 {
+class Aes128Compact {
 public:
 
 	/**
@@ -207,6 +215,20 @@ public:
 		addRoundKey (out, AES_NR);
 	}
 
+
+	/**
+	 * @brief Encrypts independent blocks, e.g. the CTR keystream of a packet
+	 *
+	 * @param 	in 			Plain text input data (16 byte per block), may be identical to out
+	 * @param 	out 		Encrypted output data (16 byte per block)
+	 * @param 	numBlocks 	Number of blocks
+	 *
+	 */
+	void chipherBlocks (const uint8_t* in, uint8_t* out, uint8_t numBlocks) {
+		for (; numBlocks > 0; --numBlocks, in += AES_BYTES, out += AES_BYTES)
+			chipher(in, out);
+	}
+
 private:
 
 	/**
@@ -394,5 +416,28 @@ private:
 };	// namespace TsUnb
 };	// namespace TsUnbLib
 
+#if defined(TSUNB_AES_HOST)
+#include "Aes128Host.h"
+#elif defined(TSUNB_AES_TTABLE)
+#include "Aes128TTable.h"
+#endif
+
+namespace TsUnbLib {
+namespace TsUnb {
+
+#if defined(TSUNB_AES_HOST)
+//! AES-128 used by the TS-UNB-Lib
+typedef Aes128Host Aes128;
+#elif defined(TSUNB_AES_TTABLE)
+//! AES-128 used by the TS-UNB-Lib
+typedef Aes128TTable Aes128;
+#else
+//! AES-128 used by the TS-UNB-Lib
+typedef Aes128Compact Aes128;
+#endif
+
+};	// namespace TsUnb
+};	// namespace TsUnbLib
+
 #endif // TSUNB_AES_H_
 
@@ -0,0 +1,293 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	AES-128 backends for host builds (e.g. Linux)
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	Aes128Host.h
+ *
+ * Aes128AesNi uses the AES instructions of x86-64 CPUs. Aes128Host offers the interface
+ * of Aes128 and selects AES-NI at runtime if the CPU supports it, otherwise it uses
+ * Aes128TTable. FixedUplinkMac encrypts its CTR
+ * keystream with chipherBlocks(), see TSUNB_MAC_CTR_BATCH_BLOCKS in FixedMac.h.
+ *
+ * Defining TSUNB_AES_HOST (CMake option of the same name, host builds only) makes
+ * Aes128Host the Aes128 of the TS-UNB-Lib, e.g. for FixedUplinkMac, see Aes128.h.
+ *
+ */
+
+
+#ifndef TSUNB_AES_HOST_H_
+#define TSUNB_AES_HOST_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#include "Aes128TTable.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define TSUNB_AES_HOST_AESNI 1
+#include <immintrin.h>
+#endif
+
+namespace TsUnbLib {
+namespace TsUnb {
+
+#if defined(TSUNB_AES_HOST_AESNI)
+
+//! Enables the AES-NI instructions for a single function
+#define TSUNB_AESNI_TARGET	__attribute__((target("aes,sse2")))
+
+/**
+ * @brief AES-128 using the AES-NI instructions of x86-64 CPUs
+ *
+ * The methods must only be called if supported() returns true.
+ */
+class Aes128AesNi {
+public:
+
+	/**
+	 * @brief Check if the CPU supports the AES-NI instructions
+	 */
+	static bool supported() {
+		return __builtin_cpu_supports("aes");
+	}
+
+	/**
+	 * @brief Initializes this module by expanding the chipher key
+	 *
+	 * @param 	key 	128-bit cipher key
+	 */
+	TSUNB_AESNI_TARGET void init (const uint8_t* const key) {
+		__m128i k = _mm_loadu_si128((const __m128i*) key);
+		roundKey[0] = k;
+		roundKey[1] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x01));
+		roundKey[2] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x02));
+		roundKey[3] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x04));
+		roundKey[4] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x08));
+		roundKey[5] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x10));
+		roundKey[6] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x20));
+		roundKey[7] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x40));
+		roundKey[8] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x80));
+		roundKey[9] = k = expandStep(k, _mm_aeskeygenassist_si128(k, 0x1B));
+		roundKey[10] = expandStep(k, _mm_aeskeygenassist_si128(k, 0x36));
+	}
+
+	/**
+	 * @brief Encrypts one block
+	 *
+	 * @param 	in 		Plain text input data (16 byte), may be identical to out
+	 * @param 	out 	Encrypted output data (16 byte)
+	 */
+	TSUNB_AESNI_TARGET void chipher (const uint8_t* const in, uint8_t* const out) const {
+		__m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i*) in), roundKey[0]);
+		for (uint8_t r = 1; r < 10; ++r)
+			s = _mm_aesenc_si128(s, roundKey[r]);
+		_mm_storeu_si128((__m128i*) out, _mm_aesenclast_si128(s, roundKey[10]));
+	}
+
+	/**
+	 * @brief Encrypts independent blocks, four at a time to fill the AES pipeline
+	 *
+	 * @param 	in 			Plain text input data (16 byte per block), may be identical to out
+	 * @param 	out 		Encrypted output data (16 byte per block)
+	 * @param 	numBlocks 	Number of blocks
+	 */
+	TSUNB_AESNI_TARGET void chipherBlocks (const uint8_t* in, uint8_t* out, uint32_t numBlocks) const {
+		for (; numBlocks >= 4; numBlocks -= 4, in += 64, out += 64) {
+			__m128i s0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*) &in[0]), roundKey[0]);
+			__m128i s1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*) &in[16]), roundKey[0]);
+			__m128i s2 = _mm_xor_si128(_mm_loadu_si128((const __m128i*) &in[32]), roundKey[0]);
+			__m128i s3 = _mm_xor_si128(_mm_loadu_si128((const __m128i*) &in[48]), roundKey[0]);
+			for (uint8_t r = 1; r < 10; ++r) {
+				s0 = _mm_aesenc_si128(s0, roundKey[r]);
+				s1 = _mm_aesenc_si128(s1, roundKey[r]);
+				s2 = _mm_aesenc_si128(s2, roundKey[r]);
+				s3 = _mm_aesenc_si128(s3, roundKey[r]);
+			}
+			_mm_storeu_si128((__m128i*) &out[0], _mm_aesenclast_si128(s0, roundKey[10]));
+			_mm_storeu_si128((__m128i*) &out[16], _mm_aesenclast_si128(s1, roundKey[10]));
+			_mm_storeu_si128((__m128i*) &out[32], _mm_aesenclast_si128(s2, roundKey[10]));
+			_mm_storeu_si128((__m128i*) &out[48], _mm_aesenclast_si128(s3, roundKey[10]));
+		}
+		for (; numBlocks > 0; --numBlocks, in += 16, out += 16)
+			chipher(in, out);
+	}
+
+private:
+
+	//! One step of the key expansion, assist is the output of AESKEYGENASSIST
+	TSUNB_AESNI_TARGET static __m128i expandStep(__m128i key, __m128i assist) {
+		assist = _mm_shuffle_epi32(assist, _MM_SHUFFLE(3, 3, 3, 3));
+		key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+		key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+		key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+		return _mm_xor_si128(key, assist);
+	}
+
+	//! Expanded key
+	__m128i roundKey[10 + 1];
+};
+
+#endif	// TSUNB_AES_HOST_AESNI
+
+
+/**
+ * @brief AES-128 for host builds, AES-NI if available
+ *
+ * Offers the interface of Aes128, chipherBlocks() encrypts independent blocks, e.g.
+ * the CTR keystream of a packet, in parallel AES-NI pipelines. Falls back to the
+ * T-table implementation if AES-NI is not available.
+ */
+class Aes128Host {
+public:
+	Aes128Host() {
+#if defined(TSUNB_AES_HOST_AESNI)
+		useAesNi = Aes128AesNi::supported();
+#endif
+	}
+
+	/**
+	 * @brief Check if AES-NI is used
+	 */
+	bool usesAesNi() const {
+#if defined(TSUNB_AES_HOST_AESNI)
+		return useAesNi;
+#else
+		return false;
+#endif
+	}
+
+	/**
+	 * @brief Initializes this module by expanding the chipher key
+	 *
+	 * @param 	key 	128-bit cipher key
+	 */
+	void init (const uint8_t* const key) {
+#if defined(TSUNB_AES_HOST_AESNI)
+		if (useAesNi) {
+			aesNi.init(key);
+			return;
+		}
+#endif
+		ttable.init(key);
+	}
+
+	/**
+	 * @brief Encrypts one block
+	 *
+	 * @param 	in 		Plain text input data (16 byte), may be identical to out
+	 * @param 	out 	Encrypted output data (16 byte)
+	 */
+	void chipher (const uint8_t* const in, uint8_t* const out) const {
+#if defined(TSUNB_AES_HOST_AESNI)
+		if (useAesNi) {
+			aesNi.chipher(in, out);
+			return;
+		}
+#endif
+		ttable.chipher(in, out);
+	}
+
+	/**
+	 * @brief Encrypts independent blocks
+	 *
+	 * @param 	in 			Plain text input data (16 byte per block), may be identical to out
+	 * @param 	out 		Encrypted output data (16 byte per block)
+	 * @param 	numBlocks 	Number of blocks
+	 */
+	void chipherBlocks (const uint8_t* const in, uint8_t* const out, const uint32_t numBlocks) const {
+#if defined(TSUNB_AES_HOST_AESNI)
+		if (useAesNi) {
+			aesNi.chipherBlocks(in, out, numBlocks);
+			return;
+		}
+#endif
+		ttable.chipherBlocks(in, out, numBlocks);
+	}
+
+private:
+#if defined(TSUNB_AES_HOST_AESNI)
+	Aes128AesNi aesNi;				//!< Used if useAesNi is set
+	bool useAesNi;					//!< CPU supports AES-NI
+#endif
+	Aes128TTable ttable;			//!< Used without AES-NI
+};
+
+};	// namespace TsUnb
+};	// namespace TsUnbLib
+
+#endif // TSUNB_AES_HOST_H_
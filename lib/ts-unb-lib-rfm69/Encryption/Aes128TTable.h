@@ -0,0 +1,289 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	Word oriented AES-128 encryption using a T-table
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	Aes128TTable.h
+ *
+ * This file implements the same AES-128 encryption as Aes128.h, but works on 32 bit
+ * columns: SubBytes, ShiftRows and MixColumns of a round are combined into four lookups
+ * of a 1 kB table per column (T-table, the other three tables of the classic
+ * implementation are rotations of it). The table is placed according to TableMemory.h,
+ * i.e. in SRAM with TSUNB_TABLES_IN_RAM. Select it with TSUNB_AES_TTABLE, see Aes128.h.
+ *
+ */
+
+
+#ifndef TSUNB_AES_TTABLE_H_
+#define TSUNB_AES_TTABLE_H_
+
+#include <stdint.h>
+
+#include "../Utils/TableMemory.h"
+
+namespace TsUnbLib {
+namespace TsUnb {
+
+/**
+ * @brief Lookup tables of the T-table AES, wrapped into a struct to allow compile time generation
+ */
+struct AesTTables {
+	uint32_t te[256];		//!< Column {2, 1, 1, 3} * S(x) of MixColumns, first row in the MSB
+	uint8_t sBox[256];		//!< S-box for the last round and the key expansion
+};
+
+/**
+ * @brief Multiplication by x in GF(2^8)
+ */
+constexpr uint8_t aesXtime(const uint8_t a) {
+	return (uint8_t)((a << 1) ^ ((a & 0x80) ? 0x1B : 0x00));
+}
+
+/**
+ * @brief Multiplication in GF(2^8)
+ */
+constexpr uint8_t aesGfMul(uint8_t a, uint8_t b) {
+	uint8_t r = 0;
+	while (b) {
+		if (b & 1)
+			r ^= a;
+		a = aesXtime(a);
+		b >>= 1;
+	}
+	return r;
+}
+
+/**
+ * @brief Generate the T-table and the S-box at compile time (FIPS-197, 5.1.1 and 5.1.3)
+ *
+ * @return	Lookup tables
+ */
+constexpr AesTTables makeAesTTables() {
+	AesTTables t = {};
+	for (uint16_t x = 0; x < 256; ++x) {
+		// Multiplicative inverse x^254, 0 maps to 0
+		uint8_t inv = 1;
+		for (uint8_t i = 0; i < 254; ++i)
+			inv = aesGfMul(inv, (uint8_t)x);
+		if (x == 0)
+			inv = 0;
+
+		// Affine transformation
+		uint8_t s = 0x63 ^ inv;
+		for (uint8_t i = 1; i <= 4; ++i)
+			s ^= (uint8_t)((inv << i) | (inv >> (8 - i)));
+
+		t.sBox[x] = s;
+		t.te[x] = ((uint32_t)aesXtime(s) << 24) | ((uint32_t)s << 16) | ((uint32_t)s << 8)
+				| (uint32_t)(aesXtime(s) ^ s);
+	}
+	return t;
+}
+
+//! T-table and S-box of the AES
+TSUNB_TABLE_ATTR inline const AesTTables TSUNB_AES_TTABLES = makeAesTTables();
+
+
+/**
+ * @brief Implementation of AES-128 for ETSI TS 103 357 TS-UNB using a T-table
+ *
+ * Offers the same interface as Aes128Compact, see Aes128.h.
+ *
+ */
+class Aes128TTable {
+public:
+
+	/**
+	 * @brief Initializes this module by expanding the chipher key
+	 *
+	 * @param 	key 	128-bit cipher key
+	 *
+	 */
+	void init (const uint8_t* const key) {
+		for (uint8_t i = 0; i < 4; ++i)
+			roundKey[i] = load(&key[i << 2]);
+
+		uint8_t rcon = 0x01;
+		for (uint8_t i = 4; i < 4 * (10 + 1); ++i) {
+			uint32_t temp = roundKey[i - 1];
+			if ((i & 3) == 0) {
+				// RotWord, SubWord and Rcon
+				temp = ((uint32_t)(sBox(temp >> 16) ^ rcon) << 24) | ((uint32_t)sBox(temp >> 8) << 16)
+						| ((uint32_t)sBox(temp) << 8) | sBox(temp >> 24);
+				rcon = aesXtime(rcon);
+			}
+			roundKey[i] = roundKey[i - 4] ^ temp;
+		}
+	}
+
+
+	/**
+	 * @brief Encrypts the input data using the AES-128 algorithm
+	 *
+	 * @param 	in 		Plain text input data (16 byte), may be identical to out
+	 * @param 	out 	Encrypted output data (16 byte)
+	 *
+	 */
+	void chipher (const uint8_t* const in, uint8_t* const out) const {
+		uint32_t s0 = load(&in[0]) ^ roundKey[0];
+		uint32_t s1 = load(&in[4]) ^ roundKey[1];
+		uint32_t s2 = load(&in[8]) ^ roundKey[2];
+		uint32_t s3 = load(&in[12]) ^ roundKey[3];
+
+		const uint32_t* rk = &roundKey[4];
+		for (uint8_t round = 1; round < 10; ++round, rk += 4) {
+			const uint32_t t0 = column(s0, s1, s2, s3) ^ rk[0];
+			const uint32_t t1 = column(s1, s2, s3, s0) ^ rk[1];
+			const uint32_t t2 = column(s2, s3, s0, s1) ^ rk[2];
+			const uint32_t t3 = column(s3, s0, s1, s2) ^ rk[3];
+			s0 = t0;
+			s1 = t1;
+			s2 = t2;
+			s3 = t3;
+		}
+
+		store(lastColumn(s0, s1, s2, s3) ^ rk[0], &out[0]);
+		store(lastColumn(s1, s2, s3, s0) ^ rk[1], &out[4]);
+		store(lastColumn(s2, s3, s0, s1) ^ rk[2], &out[8]);
+		store(lastColumn(s3, s0, s1, s2) ^ rk[3], &out[12]);
+	}
+
+
+	/**
+	 * @brief Encrypts independent blocks, e.g. the CTR keystream of a packet
+	 *
+	 * @param 	in 			Plain text input data (16 byte per block), may be identical to out
+	 * @param 	out 		Encrypted output data (16 byte per block)
+	 * @param 	numBlocks 	Number of blocks
+	 *
+	 */
+	void chipherBlocks (const uint8_t* in, uint8_t* out, uint32_t numBlocks) const {
+		for (; numBlocks > 0; --numBlocks, in += 16, out += 16)
+			chipher(in, out);
+	}
+
+private:
+
+	//! Load a column, first byte in the MSB
+	static uint32_t load(const uint8_t* const p) {
+		return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+	}
+
+	//! Store a column, first byte from the MSB
+	static void store(const uint32_t w, uint8_t* const p) {
+		p[0] = (uint8_t)(w >> 24);
+		p[1] = (uint8_t)(w >> 16);
+		p[2] = (uint8_t)(w >> 8);
+		p[3] = (uint8_t)w;
+	}
+
+	static uint32_t rotr(const uint32_t w, const uint8_t n) {
+		return (w >> n) | (w << (32 - n));
+	}
+
+	static uint32_t te(const uint32_t idx) {
+		return TSUNB_TABLE_READ_DWORD(TSUNB_AES_TTABLES.te[idx & 0xFF]);
+	}
+
+	static uint8_t sBox(const uint32_t idx) {
+		return TSUNB_TABLE_READ_BYTE(TSUNB_AES_TTABLES.sBox[idx & 0xFF]);
+	}
+
+	/**
+	 * @brief SubBytes, ShiftRows and MixColumns of one output column
+	 *
+	 * Row r of the output column is taken from the input column c + r (ShiftRows).
+	 */
+	static uint32_t column(const uint32_t c0, const uint32_t c1, const uint32_t c2, const uint32_t c3) {
+		return te(c0 >> 24) ^ rotr(te(c1 >> 16), 8) ^ rotr(te(c2 >> 8), 16) ^ rotr(te(c3), 24);
+	}
+
+	//! SubBytes and ShiftRows of one output column for the last round
+	static uint32_t lastColumn(const uint32_t c0, const uint32_t c1, const uint32_t c2, const uint32_t c3) {
+		return ((uint32_t)sBox(c0 >> 24) << 24) | ((uint32_t)sBox(c1 >> 16) << 16)
+				| ((uint32_t)sBox(c2 >> 8) << 8) | sBox(c3);
+	}
+
+	//! Expanded key, 4 columns per round
+	uint32_t roundKey[4 * (10 + 1)];
+
+};
+
+};	// namespace TsUnb
+};	// namespace TsUnbLib
+
+#endif // TSUNB_AES_TTABLE_H_
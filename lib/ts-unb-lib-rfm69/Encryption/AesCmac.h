@@ -0,0 +1,249 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	Streaming AES-CMAC (NIST SP 800-38B) with fused CTR encryption
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	AesCmac.h
+ *
+ * The message is passed in arbitrary fragments with update(), e.g. MAC header, MPF
+ * field and payload, without assembling it in one buffer. The chaining value is
+ * updated in place and a block is only encrypted when the next byte arrives, as the
+ * last block is combined with the subkey K1 or K2 by final(). updateEncrypt() XORs a
+ * CTR keystream onto the data and authenticates the ciphertext in the same pass.
+ *
+ */
+
+
+#ifndef TSUNB_AES_CMAC_H_
+#define TSUNB_AES_CMAC_H_
+
+#include <stdint.h>
+
+#include "Aes128.h"
+
+/**
+ * @brief CMAC subkey generation constant RB
+ */
+#define CMAC_RB             0x87u
+
+namespace TsUnbLib {
+namespace TsUnb {
+
+/**
+ * @brief AES-128 CMAC with init/update/final interface
+ *
+ * setKey() expands the key and generates the subkeys once, any number of tags can be
+ * calculated with the same key afterwards.
+ */
+class AesCmac {
+public:
+	//! Block size of the AES in bytes
+	static const uint8_t BLOCK_SIZE = 16;
+
+	/**
+	 * @brief Expands the key and generates the CMAC subkeys K1 and K2
+	 *
+	 * @param 	key 	128-bit key
+	 */
+	void setKey(const uint8_t* const key) {
+		Aes.init(key);
+
+		for (uint8_t i = 0; i < BLOCK_SIZE; ++i)
+			subkey1[i] = 0;
+		Aes.chipher(subkey1, subkey1);
+		doubleBlock(subkey1, subkey1);
+		doubleBlock(subkey1, subkey2);
+	}
+
+	/**
+	 * @brief AES with the expanded key, e.g. for the CTR keystream
+	 */
+	Aes128& aes() {
+		return Aes;
+	}
+
+	/**
+	 * @brief Starts a new tag
+	 */
+	void init() {
+		for (uint8_t i = 0; i < BLOCK_SIZE; ++i)
+			state[i] = 0;
+		used = 0;
+	}
+
+	/**
+	 * @brief Starts a new tag with a given chaining value
+	 *
+	 * Continues a CMAC whose preceding blocks are already processed, e.g. the encrypted
+	 * initialization vector of TS-UNB.
+	 *
+	 * @param 	chainingValue 	Encryption result of the preceding block (16 byte)
+	 */
+	void init(const uint8_t* const chainingValue) {
+		for (uint8_t i = 0; i < BLOCK_SIZE; ++i)
+			state[i] = chainingValue[i];
+		used = 0;
+	}
+
+	/**
+	 * @brief Adds a fragment of the message
+	 *
+	 * @param 	data 	Message fragment
+	 * @param 	len 	Length of the fragment in bytes
+	 */
+	void update(const uint8_t* const data, const uint16_t len) {
+		for (uint16_t i = 0; i < len; ) {
+			const uint8_t end = nextChunkEnd(len - i);
+			for (; used < end; ++used)
+				state[used] ^= data[i++];
+		}
+	}
+
+	/**
+	 * @brief Encrypts a fragment in place with a keystream and adds the ciphertext to the message
+	 *
+	 * @param 	data 		Plain text, replaced by the cipher text
+	 * @param 	len 		Length of the fragment in bytes
+	 * @param 	keystream 	Keystream, at least len bytes
+	 */
+	void updateEncrypt(uint8_t* const data, const uint16_t len, const uint8_t* const keystream) {
+		for (uint16_t i = 0; i < len; ) {
+			const uint8_t end = nextChunkEnd(len - i);
+			for (; used < end; ++used, ++i) {
+				data[i] ^= keystream[i];
+				state[used] ^= data[i];
+			}
+		}
+	}
+
+	/**
+	 * @brief Finishes the tag
+	 *
+	 * @param 	tag 	Output of the 16 byte tag, may be truncated by the caller
+	 */
+	void final(uint8_t* const tag) {
+		if (used == BLOCK_SIZE) {
+			for (uint8_t i = 0; i < BLOCK_SIZE; ++i)
+				state[i] ^= subkey1[i];
+		}
+		else {
+			state[used] ^= 0x80u;
+			for (uint8_t i = 0; i < BLOCK_SIZE; ++i)
+				state[i] ^= subkey2[i];
+		}
+		Aes.chipher(state, tag);
+	}
+
+private:
+
+	//! End of the part of the current block which takes the remaining input, encrypts a complete block first
+	uint8_t nextChunkEnd(const uint16_t remaining) {
+		if (used == BLOCK_SIZE) {
+			Aes.chipher(state, state);
+			used = 0;
+		}
+		return remaining < (uint16_t) (BLOCK_SIZE - used) ? used + remaining : BLOCK_SIZE;
+	}
+
+	//! Multiplication by x in GF(2^128) for the subkey generation
+	static void doubleBlock(const uint8_t* const in, uint8_t* const out) {
+		const uint8_t msb = in[0] >> 7;
+		for (uint8_t i = 0; i < BLOCK_SIZE - 1; ++i)
+			out[i] = (uint8_t) (in[i] << 1) | (in[i + 1] >> 7);
+		out[BLOCK_SIZE - 1] = (uint8_t) (in[BLOCK_SIZE - 1] << 1) ^ (msb ? CMAC_RB : 0x00u);
+	}
+
+	//! AES with the expanded key
+	Aes128 Aes;
+
+	//! Subkey K1, applied to a complete last block
+	uint8_t subkey1[BLOCK_SIZE];
+
+	//! Subkey K2, applied to an incomplete (padded) last block
+	uint8_t subkey2[BLOCK_SIZE];
+
+	//! Chaining value XOR the bytes of the current block
+	uint8_t state[BLOCK_SIZE];
+
+	//! Number of bytes of the current block in state
+	uint8_t used;
+};
+
+};	// namespace TsUnb
+};	// namespace TsUnbLib
+
+#endif // TSUNB_AES_CMAC_H_
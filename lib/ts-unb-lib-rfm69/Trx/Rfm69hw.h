@@ -68,6 +68,9 @@ Am Wolfsmantel 33
 91058 Erlangen, Germany
 ks-contracts@iis.fraunhofer.de
 
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
 ----------------------------------------------------------------------------- */
 
 /**
@@ -86,11 +89,16 @@ ks-contracts@iis.fraunhofer.de
 #include <stdint.h>
 
 #include "../Utils/BitAccess.h"
+#include "../Utils/CodeMemory.h"
+#include "TxSequence.h"
 
 namespace TsUnbLib {
 namespace Trx {
 
 
+//! Write access to the 'RegFifo' register, all bytes of a transaction are written to the FIFO
+#define RFM69_WRITE_FIFO			0x80
+
 //! Write access to the 'RegDataModul' register
 #define RFM69_WRITE_DATA_MODUL		0x82
 //! Register setting for continuous mode without bit synchronizer 
@@ -175,6 +183,18 @@ namespace Trx {
  * The template class RadioBurst_T defines a radio burst data structure. The actual implementation has to
  * offer the methods: uint16_t getBurstLength(void), uint8_t* getBurst(void), uint16_t get_channel(void).
  *
+ * If the platform Cpu_T offers a transmit sequencer (see HasTxSequencer), all SPI transactions
+ * of a packet are prepared in a TxSequence and sent by the sequencer. Otherwise, or if the
+ * sequencer is not available, the bursts are sent by transmitBursts() using the timer and
+ * SPI methods of Cpu_T.
+ *
+ * Without pre-tuning the frequency and the FIFO of a burst are written when the radio wakes up
+ * TX_SETUP_DELAY symbols before the burst. If PRETUNE is set, they are written during the gap
+ * after the previous burst, while the radio sleeps. The wake-up before the burst then only starts
+ * the synthesizer, PRETUNE_SETUP_DELAY symbols ahead, which is the datasheet maximum of the
+ * oscillator and synthesizer start-up rounded up to symbols. The TX command is sent on the burst
+ * symbol in both cases.
+ *
  * At an early stage in the program the init() method shall be called. It brings the device into the sleep
  * mode to save energy. It is not part of the constructor to allow the user to start a watchdog before
  * calling the init() method.
@@ -183,10 +203,11 @@ namespace Trx {
  * @tparam		BOOST_PIN		Use of the PA BOOST pin (depends on the hardware, default is off)
  * @tparam		F_DEV			Frequency deviation resgister setting
  * @tparam		RadioBurst_T	Radio burst class
+ * @tparam		PRETUNE			Write frequency and FIFO of the next burst between the bursts (default is off)
  *
  */
 template <class Cpu_T, bool BOOST_PIN = false, uint32_t F_DEV = 10, 
-class RadioBurst_T = TsUnb::RadioBurst<> >
+class RadioBurst_T = TsUnb::RadioBurst<>, bool PRETUNE = false>
 class Rfm69hw {
 public:
 	Cpu_T Cpu;
@@ -241,16 +262,212 @@ public:
 	}
 
 
-	int16_t transmit(const RadioBurst_T* const Bursts, const uint16_t numTxBursts, const uint32_t frequency) {
+	/**
+	 * @brief Transmits the radio bursts
+	 *
+	 * The burst frequencies are taken from the frequency register images of the bursts,
+	 * which have to be set with RadioBurst::setFrequencyReg() (done by SimpleNode).
+	 *
+	 * @param	Bursts		Radio bursts
+	 * @param	numTxBursts	Number of radio bursts
+	 *
+	 * @return	0
+	 */
+	int16_t transmit(const RadioBurst_T* const Bursts, const uint16_t numTxBursts) {
 		Cpu.spiInit();
 
 		Cpu.initTimer();
 		setTxPwrReg(txPower);
 
-		// Give the system the time of four bits to initialize everything (approx. 10ms)
-		Cpu.addTimerDelay(4);
-		Cpu.startTimer();
+		// With pre-tuning the first burst is loaded before the timer starts, all others after the previous burst
+		if (PRETUNE) {
+			const uint16_t firstIdx = nextBurst(Bursts, 0, numTxBursts);
+			if (firstIdx < numTxBursts)
+				loadBurst(Bursts[firstIdx]);
+		}
+
+		if (!transmitSequence(Bursts, numTxBursts, SequencerTag<HasTxSequencer<Cpu_T>::value>())) {
+			// Give the system the time of four bits to initialize everything (approx. 10ms)
+			Cpu.addTimerDelay(START_DELAY);
+			Cpu.startTimer();
+
+			transmitBursts(Bursts, numTxBursts);
+		}
+
+		//Cpu.waitTimer();
+		setMode(RFM69_MODE_SLEEP);
+		Cpu.stopTimer();
+		Cpu.spiDeinit();
+
+		return 0;
+	}
+
+	/**
+	 * @brief Sets the transmit power
+	 *
+	 * This method is used to set the transmit power in dBm.
+	 * The default transmit power is 13dBm.
+	 *
+	 * @param 	power	Transmit power in dBm
+	 */
+	void setTxPower(const int8_t power) {
+		txPower = power;
+	}
+
+private:
+
+	//! Delay before the first burst in symbols
+	static const uint16_t START_DELAY = 4;
+
+	/**
+	 * @brief Symbols between the wake-up before a burst and the start of the transmission
+	 *
+	 * Without pre-tuning the frequency and the FIFO are written and the synthesizer is started at the wake-up,
+	 * which takes three SPI transactions with 13 bytes (26 us at 4 MHz plus the chip select).
+	 * The delay is dominated by the radio: coming from sleep mode the crystal oscillator and
+	 * the synthesizer take up to 500 us + 150 us (RFM69HW datasheet, TS_OSC and TS_FS).
+	 */
+	static const uint16_t TX_SETUP_DELAY = 2;
+
+	//! RFM69HW datasheet: maximum crystal oscillator wake-up time TS_OSC in us
+	static constexpr float TS_OSC_MAX_US = 500;
+
+	//! RFM69HW datasheet: maximum synthesizer wake-up time from standby to PLL lock TS_FS in us
+	static constexpr float TS_FS_MAX_US = 150;
+
+	//! Allowance for the timer wake-up and the FS command before the synthesizer starts in us
+	static constexpr float TS_WAKEUP_US = 20;
+
+	/**
+	 * @brief Symbols between the FS command and the burst with pre-tuning
+	 *
+	 * Only the FS command is sent at the wake-up, so the radio has to stay in FS and standby only
+	 * for the start-up from sleep mode: TS_OSC + TS_FS, rounded up to whole symbols. This is two
+	 * symbols at 2380.371 sym/s and one symbol at 396.729 sym/s.
+	 */
+	static const uint16_t PRETUNE_SETUP_DELAY =
+			(uint16_t) ((TS_OSC_MAX_US + TS_FS_MAX_US + TS_WAKEUP_US) / Cpu_T::TS_UNB_BIT_DURATION_US) + 1;
+
+	/**
+	 * @brief Symbols between the end of a burst and writing the next burst with pre-tuning
+	 *
+	 * The FIFO can only be written once the transition from TX to sleep mode has finished (ModeReady).
+	 */
+	static const uint16_t PRETUNE_LOAD_DELAY = 1;
+
+	//! Symbols between the wake-up before a burst and the start of the transmission
+	static const uint16_t SETUP_DELAY = PRETUNE ? PRETUNE_SETUP_DELAY : TX_SETUP_DELAY;
+
+	//! Length of the FIFO transaction: write access, burst data and one dummy byte
+	static const uint8_t FIFO_FRAME_LENGTH = RadioBurst_T::BURST_LENGTH_BYTES + 2;
+
+	//! Length of the frequency transaction: write access and the three FRF registers
+	static const uint8_t FRF_FRAME_LENGTH = RadioBurst_T::FREQUENCY_REG_BYTES + 1;
+
+	//! Selects transmitSequence() depending on the availability of a transmit sequencer
+	template <bool SEQUENCER>
+	struct SequencerTag {
+	};
+
+	/**
+	 * @brief Platform without transmit sequencer
+	 *
+	 * @return	false, the bursts have to be sent by transmitBursts()
+	 */
+	bool transmitSequence(const RadioBurst_T* const Bursts, const uint16_t numTxBursts,
+			SequencerTag<false>) {
+		return false;
+	}
+
+	/**
+	 * @brief Transmission using the transmit sequencer of the platform
+	 *
+	 * Prepares the command list and runs it. The timer must be initialized.
+	 *
+	 * @return	false if nothing has been sent, e.g. the list is too short or the sequencer is not available
+	 */
+	bool transmitSequence(const RadioBurst_T* const Bursts, const uint16_t numTxBursts,
+			SequencerTag<true>) {
+		typename Cpu_T::TxSequence_t& sequence = Cpu.getTxSequence();
+		if (!buildSequence(sequence, Bursts, numTxBursts))
+			return false;
+
+		return Cpu.runSequence();
+	}
 
+	/**
+	 * @brief Prepares the SPI transactions of all bursts
+	 *
+	 * The command list has exactly the timing and the SPI transactions of transmitBursts().
+	 *
+	 * @param	sequence	Command list, see TxSequence
+	 *
+	 * @return	false if the command list is too short
+	 */
+	template <class Sequence_T>
+	bool buildSequence(Sequence_T& sequence, const RadioBurst_T* const Bursts, const uint16_t numTxBursts) const {
+		sequence.clear();
+
+		const uint8_t modeFs[2] = {RFM69_WRITE_MODE, RFM69_MODE_FS};
+		const uint8_t modeTx[2] = {RFM69_WRITE_MODE, RFM69_MODE_TX};
+		const uint8_t modeSleep[2] = {RFM69_WRITE_MODE, RFM69_MODE_SLEEP};
+
+		int16_t delay = START_DELAY;
+		bool loaded = PRETUNE;
+		for (uint16_t burstIdx = 0; burstIdx < numTxBursts; ++burstIdx) {
+			// Zero length bursts only keep the timing
+			if (Bursts[burstIdx].getBurstLength() == 0) {
+				if (!sequence.addStep(delay))
+					return false;
+				delay = Bursts[burstIdx].get_T_RB();
+				continue;
+			}
+
+			// SETUP_DELAY symbols before the burst: frequency and FIFO data if not loaded yet, synthesizer on
+			if (!(sequence.addStep(delay) && (loaded || addLoadFrames(sequence, Bursts[burstIdx]))
+					&& sequence.addFrame(modeFs, 2)
+					&& sequence.addStep(SETUP_DELAY) && sequence.addFrame(modeTx, 2)
+					&& sequence.addStep(Bursts[burstIdx].getBurstLength()) && sequence.addFrame(modeSleep, 2)))
+				return false;
+
+			delay = Bursts[burstIdx].get_T_RB() - Bursts[burstIdx].getBurstLength() - SETUP_DELAY;
+			loaded = false;
+			if (PRETUNE && burstIdx + 1 < numTxBursts && delay > PRETUNE_LOAD_DELAY) {
+				const uint16_t nextIdx = nextBurst(Bursts, burstIdx + 1, numTxBursts);
+				if (nextIdx < numTxBursts) {
+					if (!(sequence.addStep(PRETUNE_LOAD_DELAY) && addLoadFrames(sequence, Bursts[nextIdx])))
+						return false;
+					delay -= PRETUNE_LOAD_DELAY;
+					loaded = true;
+				}
+			}
+		}
+		return sequence.getNumSteps() != 0;
+	}
+
+	/**
+	 * @brief Adds the frequency and FIFO transactions of loadBurst() to the current step
+	 *
+	 * @return	false if the command list is too short
+	 */
+	template <class Sequence_T>
+	static bool addLoadFrames(Sequence_T& sequence, const RadioBurst_T& burst) {
+		uint8_t frf[FRF_FRAME_LENGTH];
+		frequencyFrame(frf, burst);
+		uint8_t fifo[FIFO_FRAME_LENGTH];
+		fifoFrame(fifo, burst);
+		return sequence.addFrame(frf, FRF_FRAME_LENGTH) && sequence.addFrame(fifo, FIFO_FRAME_LENGTH);
+	}
+
+	/**
+	 * @brief Burst sequencing of transmit(), executed while the symbol timer is running
+	 *
+	 * This is the time-critical part of the transmission. It is placed in SRAM if
+	 * TSUNB_TX_IN_RAM is defined, everything it calls must be placed there as well.
+	 */
+	TSUNB_TIME_CRITICAL void transmitBursts(const RadioBurst_T* const Bursts, const uint16_t numTxBursts) {
+		// With pre-tuning transmit() has already loaded the first burst
+		bool loaded = PRETUNE;
 		for (uint16_t burstIdx = 0; burstIdx < numTxBursts;	++burstIdx) {
 			Cpu.resetWatchdog();
 
@@ -263,26 +480,12 @@ public:
 				continue;
 			}
 
-			const uint32_t cFrequency = (uint32_t) Bursts[burstIdx].getCarrierOffset();
-			const uint32_t modFreq = frequency + cFrequency;
 			Cpu.waitTimer();
-			setFrequencyReg(modFreq);
-
-			const uint8_t* burstData = Bursts[burstIdx].getBurst();
-			for (uint8_t byteIdx = 0; byteIdx < Bursts[burstIdx].getBurstLengthBytes(); ++byteIdx) {
-				uint8_t data[2] = {0x80, burstData[byteIdx]};
-				Cpu.spiSend(data, 2);
-			}
-
-			// Add one dummy byte, if this byte is actually transmitted, the TX switches itself into sleep mode 
-			// because we did not set  the sleep command
-			{
-				uint8_t data[2] = {0x80, 0};
-				Cpu.spiSend(data, 2);
-			}
+			if (!loaded)
+				loadBurst(Bursts[burstIdx]);
 			setMode(RFM69_MODE_FS);
 
-			Cpu.addTimerDelay(2);
+			Cpu.addTimerDelay(SETUP_DELAY);
 			Cpu.waitTimer();
 			setMode(RFM69_MODE_TX);
 
@@ -294,56 +497,102 @@ public:
 			 * If we are not in the last burst wait for the next burst to start.
 			 * If we are in the last burst we do not have to restart the counter again.
 			 * 
-			 * We wake up 2 bits before the new burst starts. This gives us enough time to shift the
-			 * data into the FIFO before the next transmission starts.
+			 * We wake up SETUP_DELAY bits before the new burst starts. This gives us enough time to
+			 * shift the data into the FIFO and to settle the synthesizer before the next transmission starts.
+			 * With pre-tuning the next burst is loaded PRETUNE_LOAD_DELAY symbols after this burst
+			 * if the gap is long enough, and the wake-up before the burst only starts the synthesizer.
 			 */
-			if (burstIdx <= numTxBursts) {
-				Cpu.addTimerDelay((int16_t)Bursts[burstIdx].get_T_RB() - Bursts[burstIdx].getBurstLength() - 2);
+			loaded = false;
+			if (burstIdx + 1 < numTxBursts) {
+				int16_t delay = (int16_t)Bursts[burstIdx].get_T_RB() - Bursts[burstIdx].getBurstLength() - SETUP_DELAY;
+				if (PRETUNE && delay > PRETUNE_LOAD_DELAY) {
+					const uint16_t nextIdx = nextBurst(Bursts, burstIdx + 1, numTxBursts);
+					if (nextIdx < numTxBursts) {
+						Cpu.addTimerDelay(PRETUNE_LOAD_DELAY);
+						Cpu.waitTimer();
+						loadBurst(Bursts[nextIdx]);
+						delay -= PRETUNE_LOAD_DELAY;
+						loaded = true;
+					}
+				}
+				Cpu.addTimerDelay(delay);
 			}
 		}
-		//Cpu.waitTimer();
-		setMode(RFM69_MODE_SLEEP);
-		Cpu.stopTimer();
-		Cpu.spiDeinit();
-
-		return 0;
 	}
 
 	/**
-	 * @brief Sets the transmit power
+	 * @brief Writes the frequency and the FIFO data of a burst
 	 *
-	 * This method is used to set the transmit power in dBm.
-	 * The default transmit power is 13dBm.
+	 * Burst data and one dummy byte are written in a single FIFO transaction. If the dummy byte is actually
+	 * transmitted, the TX switches itself into sleep mode because we did not set the sleep command.
+	 * Caution: This method assumes that SPI is initialized and the radio is in sleep mode!
 	 *
-	 * @param 	power	Transmit power in dBm
+	 * @param	burst		Radio burst with non-zero length
 	 */
-	void setTxPower(const int8_t power) {
-		txPower = power;
+	TSUNB_TIME_CRITICAL void loadBurst(const RadioBurst_T& burst) {
+		setFrequencyReg(burst);
+
+		uint8_t data[FIFO_FRAME_LENGTH];
+		fifoFrame(data, burst);
+		Cpu.spiSend(data, FIFO_FRAME_LENGTH);
 	}
 
-private:
+	/**
+	 * @brief Index of the next burst with non-zero length
+	 *
+	 * @param	burstIdx	Index of the first burst to check
+	 *
+	 * @return	Index of the burst, numTxBursts if there is none
+	 */
+	static TSUNB_TIME_CRITICAL uint16_t nextBurst(const RadioBurst_T* const Bursts, uint16_t burstIdx, const uint16_t numTxBursts) {
+		while (burstIdx < numTxBursts && Bursts[burstIdx].getBurstLength() == 0)
+			++burstIdx;
+		return burstIdx;
+	}
 
 	/**
 	 * @brief Set frequency register
 	 *
-	 * This method sets the frequency register to the value frequency.
+	 * This method sets the frequency register to the precomputed frequency of the burst.
 	 * Caution: This method assumes that SPI is initialized!
 	 *
+	 * @param	burst		Radio burst with non-zero length
 	 */
-	void setFrequencyReg(const uint32_t frequency) {
-		/*
-		 * Union to simplify byte access.
-		 */
-		union splituint32 {
-			uint8_t bytes[4];
-			uint32_t single;
-		};
-		union splituint32 regVal;
-		regVal.single = frequency;
-		uint8_t data[4] = {
-				RFM69_WRITE_FRF, regVal.bytes[2],
-				regVal.bytes[1], regVal.bytes[0]};
-		Cpu.spiSend(data, 4);
+	TSUNB_TIME_CRITICAL void setFrequencyReg(const RadioBurst_T& burst) {
+		uint8_t data[FRF_FRAME_LENGTH];
+		frequencyFrame(data, burst);
+		Cpu.spiSend(data, FRF_FRAME_LENGTH);
+	}
+
+	/**
+	 * @brief SPI transaction writing the data of a burst and one dummy byte to the FIFO
+	 *
+	 * @param	data		Buffer for the FIFO_FRAME_LENGTH bytes of the transaction
+	 * @param	burst		Radio burst with non-zero length
+	 */
+	static TSUNB_TIME_CRITICAL_INLINE void fifoFrame(uint8_t* const data, const RadioBurst_T& burst) {
+		const uint8_t* burstData = burst.getBurst();
+		data[0] = RFM69_WRITE_FIFO;
+		for (uint8_t byteIdx = 0; byteIdx < RadioBurst_T::BURST_LENGTH_BYTES; ++byteIdx) {
+			data[byteIdx + 1] = burstData[byteIdx];
+		}
+		data[FIFO_FRAME_LENGTH - 1] = 0;
+	}
+
+	/**
+	 * @brief SPI transaction writing the frequency register
+	 *
+	 * Only copies the frequency register image of the burst, see RadioBurst::setFrequencyReg().
+	 *
+	 * @param	data		Buffer for the FRF_FRAME_LENGTH bytes of the transaction
+	 * @param	burst		Radio burst with non-zero length
+	 */
+	static TSUNB_TIME_CRITICAL_INLINE void frequencyFrame(uint8_t* const data, const RadioBurst_T& burst) {
+		const uint8_t* frequencyReg = burst.getFrequencyReg();
+		data[0] = RFM69_WRITE_FRF;
+		for (uint8_t byteIdx = 0; byteIdx < RadioBurst_T::FREQUENCY_REG_BYTES; ++byteIdx) {
+			data[byteIdx + 1] = frequencyReg[byteIdx];
+		}
 	}
 	
 	/**
@@ -409,7 +658,7 @@ private:
 	 *
 	 * @param	mode	RFM69HW mode according to datasheet
 	 */
-	void setMode(const uint8_t mode) {
+	TSUNB_TIME_CRITICAL void setMode(const uint8_t mode) {
 		uint8_t data[2] = {RFM69_WRITE_MODE, mode};
 		Cpu.spiSend(data, 2);
 	}
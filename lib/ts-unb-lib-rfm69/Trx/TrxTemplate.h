@@ -68,6 +68,9 @@ Am Wolfsmantel 33
 91058 Erlangen, Germany
 ks-contracts@iis.fraunhofer.de
 
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
 ----------------------------------------------------------------------------- */
 
 /**
@@ -160,7 +163,7 @@ public:
 	}
 
 
-	int16_t transmit(const RadioBurst_T* const Bursts, const uint16_t numTxBursts, const uint32_t frequency) {
+	int16_t transmit(const RadioBurst_T* const Bursts, const uint16_t numTxBursts) {
 		Cpu.spiInit();
 
 		Cpu.initTimer();
@@ -182,11 +185,9 @@ public:
 				continue;
 			}
 
-			// Calculate frequency register setting
-			const uint32_t cFrequency = (uint32_t) Bursts[burstIdx].getCarrierOffset();
-			const uint32_t modFreq = frequency + cFrequency;
+			// The frequency register setting f_0 + carrier offset is precomputed in the burst
 			Cpu.waitTimer();
-			setFrequencyReg(modFreq);
+			setFrequencyReg(Bursts[burstIdx].getFrequencyReg());
 
 			const uint8_t* burstData = Bursts[burstIdx].getBurst();
 			for (uint8_t byteIdx = 0; byteIdx < Bursts[burstIdx].getBurstLengthBytes(); ++byteIdx) {
@@ -238,8 +239,9 @@ private:
 	 * This method sets the frequency register to the value frequency.
 	 * Caution: This method assumes that SPI is initialized!
 	 *
+	 * @param	frequency	RadioBurst_T::FREQUENCY_REG_BYTES register bytes, most significant byte first
 	 */
-	void setFrequencyReg(const uint32_t frequency) {
+	void setFrequencyReg(const uint8_t* const frequency) {
 		//TODO Write frequency register value
 	}
 	
@@ -0,0 +1,244 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	Command list for hardware sequenced burst transmission
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	TxSequence.h
+ *
+ * Instead of writing each SPI transaction from a loop that waits for the symbol timer, the
+ * transceiver can prepare all SPI transactions of a packet in advance. A platform that offers
+ * a transmit sequencer (e.g. PIO and DMA on the RP2040) then sends the transactions of each step
+ * at its symbol instant without further involvement of the CPU.
+ *
+ */
+
+
+#ifndef TSUNB_TX_SEQUENCE_H_
+#define TSUNB_TX_SEQUENCE_H_
+
+#include <stdint.h>
+
+namespace TsUnbLib {
+namespace Trx {
+
+
+/**
+ * @brief Command list of a transmission
+ *
+ * The list consists of steps. Each step has a delay in symbols and the SPI transactions sent at
+ * the end of this delay. The delay has the meaning of addTimerDelay() called after the previous
+ * step, the delay of the first step the meaning of addTimerDelay() called before startTimer().
+ * Each SPI transaction is stored as its length in bytes followed by the bytes, i.e. the same
+ * format as the RFM69 configuration array. The transactions of a step are stored consecutively,
+ * so that a step can be sent with a single DMA transfer.
+ *
+ * @tparam	MAX_STEPS			Maximum number of steps
+ * @tparam	MAX_FRAME_BYTES		Maximum number of bytes of all transactions incl. the length bytes
+ */
+template <uint16_t MAX_STEPS, uint16_t MAX_FRAME_BYTES>
+class TxSequence {
+public:
+	//! Step of the command list
+	struct Step {
+		uint16_t delay;			//!< Delay in symbols, see addTimerDelay()
+		uint16_t frameIdx;		//!< Index of the first transaction in the frame buffer
+		uint16_t frameLength;	//!< Length of all transactions of this step in bytes
+	};
+
+	TxSequence() {
+		clear();
+	}
+
+	/**
+	 * @brief Removes all steps
+	 */
+	void clear() {
+		numSteps = 0;
+		numFrameBytes = 0;
+	}
+
+	/**
+	 * @brief Appends a step without transactions
+	 *
+	 * @param	delay	Delay in symbols, see addTimerDelay()
+	 *
+	 * @return	false if the list is full
+	 */
+	bool addStep(const uint16_t delay) {
+		if (numSteps >= MAX_STEPS)
+			return false;
+
+		steps[numSteps].delay = delay;
+		steps[numSteps].frameIdx = numFrameBytes;
+		steps[numSteps].frameLength = 0;
+		++numSteps;
+		return true;
+	}
+
+	/**
+	 * @brief Appends an SPI transaction to the last step
+	 *
+	 * @param	data		Bytes of the transaction incl. the register address
+	 * @param	numBytes	Number of bytes, at least 1
+	 *
+	 * @return	false if there is no step or the frame buffer is full
+	 */
+	bool addFrame(const uint8_t* const data, const uint8_t numBytes) {
+		if (numSteps == 0 || numBytes == 0 || numFrameBytes + numBytes + 1 > MAX_FRAME_BYTES)
+			return false;
+
+		frames[numFrameBytes++] = numBytes;
+		for (uint8_t i = 0; i < numBytes; ++i) {
+			frames[numFrameBytes++] = data[i];
+		}
+		steps[numSteps - 1].frameLength += numBytes + 1;
+		return true;
+	}
+
+	/**
+	 * @brief Get the number of steps
+	 */
+	uint16_t getNumSteps() const {
+		return numSteps;
+	}
+
+	/**
+	 * @brief Get a step
+	 *
+	 * @param	idx		Index of the step
+	 */
+	const Step& getStep(const uint16_t idx) const {
+		return steps[idx];
+	}
+
+	/**
+	 * @brief Get the transactions of a step
+	 *
+	 * @param	step	Step of this list
+	 *
+	 * @return	Pointer to the first length byte, the step has step.frameLength bytes
+	 */
+	const uint8_t* getFrames(const Step& step) const {
+		return &frames[step.frameIdx];
+	}
+
+	/**
+	 * @brief Get the number of used bytes of the frame buffer
+	 */
+	uint16_t getNumFrameBytes() const {
+		return numFrameBytes;
+	}
+
+private:
+	//! Steps of the list
+	Step steps[MAX_STEPS];
+
+	//! Transactions of all steps
+	uint8_t frames[MAX_FRAME_BYTES];
+
+	//! Number of used steps
+	uint16_t numSteps;
+
+	//! Number of used bytes in frames
+	uint16_t numFrameBytes;
+};
+
+
+/**
+ * @brief Detects whether a platform offers a transmit sequencer
+ *
+ * A platform with a sequencer defines the type TxSequence_t (a TxSequence) and the methods
+ * TxSequence_t& getTxSequence() and bool runSequence(). runSequence() is called instead of
+ * startTimer() after initTimer(). It sends the steps of getTxSequence() at their symbol instants
+ * and returns after the last step, the timer is stopped by stopTimer() afterwards. It returns
+ * false without sending anything if the sequencer is not available, in this case the transceiver
+ * falls back to the timer and SPI methods.
+ */
+template <class Cpu_T>
+struct HasTxSequencer {
+	template <class C> static char test(typename C::TxSequence_t*);
+	template <class C> static long test(...);
+
+	//! true if Cpu_T offers a transmit sequencer
+	static const bool value = sizeof(test<Cpu_T>(0)) == sizeof(char);
+};
+
+
+};	// namespace Trx
+};	// namespace TsUnbLib
+
+#endif	// TSUNB_TX_SEQUENCE_H_
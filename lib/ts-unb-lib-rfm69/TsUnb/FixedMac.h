@@ -68,6 +68,9 @@ Am Wolfsmantel 33
 91058 Erlangen, Germany
 ks-contracts@iis.fraunhofer.de
 
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
 ----------------------------------------------------------------------------- */
 
 /**
@@ -91,7 +94,7 @@ ks-contracts@iis.fraunhofer.de
 
 
 #include "../Utils/BitAccess.h"
-#include "../Encryption/Aes128.h"
+#include "../Encryption/AesCmac.h"
 
 
 namespace TsUnbLib {
@@ -113,14 +116,36 @@ namespace TsUnb {
  * @brief Block size of the AES encryption in bytes
  */
 #define BLOCK_SIZE_AES      16
-/**
- * @brief CMAC subkey generation constant RB
- */
-#define CMAC_RB             0x87u
 /**
  * @brief Length of the periodic TSMA pattern cycle
  */
 #define TSMA_PATTERN_CYCLE  15
+/**
+ * @brief MAC overhead in bytes for short addressing without MPF field
+ */
+#define MAC_OVERHEAD_SHORT_ADDR 10
+/**
+ * @brief Number of CTR keystream blocks precomputed by FixedUplinkMac::prepareNextFrame()
+ *
+ * Covers the MPF field and the payload up to 16 byte per block, further blocks are
+ * calculated by encode(). Can be defined by the application.
+ */
+#ifndef TSUNB_MAC_PREPARED_BLOCKS
+#define TSUNB_MAC_PREPARED_BLOCKS 2
+#endif
+/**
+ * @brief Maximum number of CTR keystream blocks encode() passes to one Aes128::chipherBlocks() call
+ *
+ * The host backends encrypt several independent blocks faster than single blocks, each
+ * block takes 16 byte of stack. Can be defined by the application.
+ */
+#ifndef TSUNB_MAC_CTR_BATCH_BLOCKS
+#if defined(TSUNB_AES_HOST)
+#define TSUNB_MAC_CTR_BATCH_BLOCKS 8
+#else
+#define TSUNB_MAC_CTR_BATCH_BLOCKS 1
+#endif
+#endif
 /**
  * @brief Sequence of the uplink TSMA patterns
  */
@@ -147,10 +172,17 @@ enum TsUnbAddressMode {
  */
 class FixedUplinkMac {
 public:
+	//! Maximum number of MPDU bytes in front of the MAC payload (header, EUI-64, packet counter, MPF)
+	static const uint8_t HEADROOM = 1 + 8 + 3 + 1;
+
+	//! Number of MPDU bytes behind the MAC payload (CMAC tag)
+	static const uint8_t TAG_LENGTH = 4;
+
 	FixedUplinkMac () {
 		macHeader.reg = 0x00;
 		extPkgCnt = 0;
-		Aes_p = NULL;
+		keyScheduleValid = false;
+		preparedValid = false;
 	}
 
 	/**
@@ -173,28 +205,39 @@ public:
 	 */
 	uint16_t encode(uint8_t* const mpduPayload, const uint8_t* const macPayload, const uint16_t len,
 			const bool MPF_present = false, const uint8_t MPF_value = 0) {
-		// Create AES on the stack
-		TsUnb::Aes128 Aes;
-		Aes_p = &Aes;
-		Aes_p->init(networkKey);
+		uint8_t* const dst = &mpduPayload[headerLength(MPF_present)];
+		for(uint16_t i = 0; i < len; ++i)
+			dst[i] = macPayload[i];
 
-		// Set MPF field in header
-		macHeader.bit.mpfflag = MPF_present;
+		return encodeInPlace(mpduPayload, len, MPF_present, MPF_value);
+	}
 
-		// CMAC initlization vector
-		// EUI64
-		uint8_t iv[BLOCK_SIZE_AES];
-		for(uint8_t i = 0; i < 8; ++i)
-			iv[i] = eui64[i];
-		iv[8] = 0x00u;
-		iv[9] = DATA_DIRECTION;
-		iv[10] = extPkgCnt >> 24;
-		iv[11] = extPkgCnt >> 16;
-		iv[12] = extPkgCnt >> 8;
-		iv[13] = extPkgCnt;
-		iv[14] = 0xFFu;
-		iv[15] = 0xFFu;
+	/**
+	 * @brief	Create the MPDU around a MAC payload which is already in place
+	 *
+	 * Writes the MAC header in front of the payload, encrypts the payload in place and
+	 * appends the CMAC tag. A buffer with HEADROOM bytes in front of the payload fits all
+	 * address modes, the MPDU then starts at HEADROOM - headerLength(MPF_present).
+	 *
+	 * @param	mpduPayload	MPDU buffer, the MAC payload starts at mpduPayload[headerLength(MPF_present)]
+	 *						and is followed by TAG_LENGTH free bytes
+	 * @param	len			Length of MAC payload data
+	 * @param	MPF_present	Flag if MPF field is present
+	 * @param	MPF_value	Value of MPF field (if present)
+	 *
+	 * @return	Length of the MPDU
+	 */
+	uint16_t encodeInPlace(uint8_t* const mpduPayload, const uint16_t len,
+			const bool MPF_present = false, const uint8_t MPF_value = 0) {
+		// Key expansion and CMAC subkeys are only calculated after a new network key
+		prepareKey();
+
+		// Keystream and CMAC IV of prepareNextFrame() for this packet
+		const bool prepared = isPrepared();
+		preparedValid = false;
 
+		// Set MPF field in header
+		macHeader.bit.mpfflag = MPF_present;
 
 		// Actual packet
 		uint16_t idx = 0;
@@ -218,34 +261,97 @@ public:
 		if(macHeader.bit.mpfflag)
 			mpduPayload[idx++] = MPF_value;
 
-		for(uint8_t i = 0; i < len; ++i)
-			mpduPayload[idx++] = macPayload[i];
+		// The payload is already in place
+		idx += len;
 
 
-		// Encryption with IV as input
+		// CMAC initlization vector, its encryption is the chaining value for the MPDU
+		uint8_t iv[BLOCK_SIZE_AES];
+		setInitVector(iv);
+		if (prepared) {
+			Cmac.init(preparedBlocks);
+		}
+		else {
+			uint8_t ivEnc[BLOCK_SIZE_AES];
+			Cmac.aes().chipher(iv, ivEnc);
+			Cmac.init(ivEnc);
+		}
+		Cmac.update(mpduPayload, beginEncrypted);
+
+		// Encryption with IV as input, each keystream block is authenticated right after the encryption
+		// The keystream blocks which are not prepared are encrypted in batches
+		uint8_t batch[TSUNB_MAC_CTR_BATCH_BLOCKS * BLOCK_SIZE_AES];
+		uint8_t batchBegin = 0;
+		uint8_t batchEnd = 0;
 		for(uint8_t block = 0; beginEncrypted < idx; ++block)
 		{
-			iv[14] = 0; // Block counter will never exceed one byte
-			iv[15] = block;
-			uint8_t ivEnc[BLOCK_SIZE_AES];
-			Aes_p->chipher(iv, ivEnc);
+			const uint16_t remaining = idx - beginEncrypted;
+			const uint8_t* keystream;
+			if (prepared && block < TSUNB_MAC_PREPARED_BLOCKS) {
+				keystream = &preparedBlocks[(1 + block) * BLOCK_SIZE_AES];
+			}
+			else {
+				if (block >= batchEnd) {
+					const uint16_t remainingBlocks = (remaining + BLOCK_SIZE_AES - 1) / BLOCK_SIZE_AES;
+					batchBegin = block;
+					batchEnd = block + (remainingBlocks < TSUNB_MAC_CTR_BATCH_BLOCKS ?
+							remainingBlocks : TSUNB_MAC_CTR_BATCH_BLOCKS);
+					for(uint8_t i = batchBegin; i < batchEnd; ++i)
+						setCounterBlock(&batch[(i - batchBegin) * BLOCK_SIZE_AES], iv, i);
+					Cmac.aes().chipherBlocks(batch, batch, batchEnd - batchBegin);
+				}
+				keystream = &batch[(block - batchBegin) * BLOCK_SIZE_AES];
+			}
 
-			for(uint8_t i = 0; (i < BLOCK_SIZE_AES) && (beginEncrypted < idx); ++i)
-				mpduPayload[beginEncrypted++] ^= ivEnc[i];
+			const uint8_t n = remaining < BLOCK_SIZE_AES ? remaining : BLOCK_SIZE_AES;
+			Cmac.updateEncrypt(&mpduPayload[beginEncrypted], n, keystream);
+			beginEncrypted += n;
 		}
 
-		iv[14] = 0xFFu;
-		iv[15] = 0xFFu;
-
-		cmacGenerateTag(iv, mpduPayload, idx, iv);
+		Cmac.final(iv);
 
-		for(uint8_t i = 0; i < 4; ++i)
+		for(uint8_t i = 0; i < TAG_LENGTH; ++i)
 			mpduPayload[idx++] = iv[i];
 		extPkgCnt++;
 		return idx;
 
 	}
 
+	/**
+	 * @brief	Get the number of MPDU bytes in front of the MAC payload
+	 *
+	 * @param	MPF_present			Flag if MPF field is present
+	 *
+	 * @return	Length of MAC header, address, packet counter and MPF field
+	 */
+	uint8_t headerLength(const bool MPF_present = false) const {
+		return MPDU_Length(0, MPF_present) - TAG_LENGTH;
+	}
+
+	/**
+	 * @brief	Precompute the payload independent AES blocks of the next encode()
+	 *
+	 * The CTR keystream and the encrypted CMAC initialization vector only depend on the
+	 * network key, the EUI-64 and extPkgCnt. Calling this method in idle time before the
+	 * payload is available leaves only XOR operations and the CMAC of the MPDU for encode().
+	 * The precomputed blocks are discarded if the key, the EUI-64 or extPkgCnt change
+	 * before the next encode().
+	 */
+	void prepareNextFrame() {
+		prepareKey();
+
+		// The CMAC initialization vector and the counter blocks are encrypted at once
+		setInitVector(preparedBlocks);
+		for(uint8_t block = 0; block < TSUNB_MAC_PREPARED_BLOCKS; ++block)
+			setCounterBlock(&preparedBlocks[(1 + block) * BLOCK_SIZE_AES], preparedBlocks, block);
+		Cmac.aes().chipherBlocks(preparedBlocks, preparedBlocks, 1 + TSUNB_MAC_PREPARED_BLOCKS);
+
+		for(uint8_t i = 0; i < 8; ++i)
+			preparedEui64[i] = eui64[i];
+		preparedPkgCnt = extPkgCnt;
+		preparedValid = true;
+	}
+
 	/**
 	 * @brief	Get the MPDU length for MAC_PayloadLength and MPF_present flag
 	 * 
@@ -256,7 +362,7 @@ public:
 	 * 
 	 */
 	uint16_t MPDU_Length(const uint16_t MAC_PayloadLength, const bool MPF_present = false) const {
-		uint8_t ret = 10 + MAC_PayloadLength;
+		uint16_t ret = MAC_OVERHEAD_SHORT_ADDR + MAC_PayloadLength;
 		if (MPF_present) // MPF field present
 			ret += 1;
 
@@ -304,6 +410,8 @@ public:
 	 * @param	k14	Byte 14 of network key
 	 * @param	k15	Byte 15 of network key
 	 * 
+	 * The cached AES key schedule and CMAC subkeys are recalculated by the next encode().
+	 * 
 	 */
 	void setNetworkKey(const uint8_t k0, const uint8_t k1, const uint8_t k2, const uint8_t k3,
 			const uint8_t k4, const uint8_t k5, const uint8_t k6, const uint8_t k7,
@@ -325,6 +433,8 @@ public:
 		networkKey[13] = k13;
 		networkKey[14] = k14;
 		networkKey[15] = k15;
+		keyScheduleValid = false;
+		preparedValid = false;
 	}
 
 	/**
@@ -411,7 +521,6 @@ public:
 	}
 
 
-	uint8_t networkKey[16]; /**< @brief Network key */
 	uint8_t eui64[8];       /**< @brief EUI64 */
 	uint8_t shortAddr[2];   /**< @brief Short address */
 	uint32_t extPkgCnt;     /**< @brief Extended packet counter */
@@ -419,134 +528,56 @@ public:
 
 private:
 
-	void cmacGenerateSubkey(uint8_t *subkey1, uint8_t *subkey2)
-	{
-		for(uint8_t i = 0; i < BLOCK_SIZE_AES; ++i)
-			subkey1[i] = 0;
-		Aes_p->chipher(subkey1, subkey1);
-
-		if(leftShift16byte(subkey1, subkey1))
-			subkey1[BLOCK_SIZE_AES - 1] ^= CMAC_RB;
-		if(leftShift16byte(subkey1, subkey2))
-			subkey2[BLOCK_SIZE_AES - 1] ^= CMAC_RB;
-	}
-
-	uint8_t leftShift16byte(const uint8_t *dataIn, uint8_t *dataOut) const {
-		uint8_t prevMsb = 0;
-		for(int8_t i = 15; i >= 0; --i)
-		{
-			uint8_t msb = dataIn[i] >> 7;
-			dataOut[i] = (dataIn[i] << 1) | prevMsb;
-			prevMsb = msb;
-		}
-		return prevMsb;
+	/**
+	 * @brief	CMAC initialization vector, bytes 14 and 15 are the CTR block counter
+	 */
+	void setInitVector(uint8_t* const iv) const {
+		// EUI64
+		for(uint8_t i = 0; i < 8; ++i)
+			iv[i] = eui64[i];
+		iv[8] = 0x00u;
+		iv[9] = DATA_DIRECTION;
+		iv[10] = extPkgCnt >> 24;
+		iv[11] = extPkgCnt >> 16;
+		iv[12] = extPkgCnt >> 8;
+		iv[13] = extPkgCnt;
+		iv[14] = 0xFFu;
+		iv[15] = 0xFFu;
 	}
 
-
-	void cmacGenerateTag(const uint8_t* const input, const uint16_t inputLen, uint8_t* const output) {
-		uint8_t subkey1[BLOCK_SIZE_AES], subkey2[BLOCK_SIZE_AES];
-
-		cmacGenerateSubkey(subkey1, subkey2);
-
-		uint8_t blocks = (uint16_t)(inputLen + BLOCK_SIZE_AES - 1) >> 4;
-		uint8_t flag;
-
-		if(blocks == 0)	{
-			blocks = 1;
-			flag = 0;
-		}
-		else {
-			if(inputLen & 0x000Fu)
-				flag = 0;
-			else
-				flag = 1;
-		}
-
-		for(uint8_t i = 0; i < BLOCK_SIZE_AES; ++i)
-			output[i] = 0;
-
-		for(uint16_t msg = 0; msg < (uint16_t)(blocks - 1); ++msg)
-		{
-			xor16byte(&input[msg << 4], output);
-			Aes_p->chipher(output,output);
-		}
-
-		if(flag) {
-			xor16byte(subkey1, output);
-			xor16byte(&input[(blocks-1) << 4], output);
-		}
-		else {
-			xor16byte(subkey2, output);
-			uint8_t extraBytes = inputLen & 0x000Fu;
-			for(uint8_t i = 0; i < BLOCK_SIZE_AES; ++i)	{
-				if(i < extraBytes)
-					output[i] ^= input[((blocks-1) << 4) + i];
-				else if(i == extraBytes)
-					output[i] ^= 0x80u;
-				else
-					output[i] ^= 0x00u;
-			}
-		}
-		Aes_p->chipher(output,output);
+	/**
+	 * @brief	CTR counter block, i.e. the CMAC initialization vector with the block counter
+	 */
+	static void setCounterBlock(uint8_t* const counterBlock, const uint8_t* const iv, const uint8_t block) {
+		for(uint8_t i = 0; i < 14; ++i)
+			counterBlock[i] = iv[i];
+		counterBlock[14] = 0; // Block counter will never exceed one byte
+		counterBlock[15] = block;
 	}
 
-	void cmacGenerateTag(uint8_t* const cmacInitVector, const uint8_t* const input, const uint16_t inputLen, uint8_t* const output) {
-		uint8_t subkey1[BLOCK_SIZE_AES], subkey2[BLOCK_SIZE_AES];
-
-		cmacGenerateSubkey(subkey1, subkey2);
-
-		uint8_t blocks = (uint16_t)(inputLen + BLOCK_SIZE_AES - 1) >> 4;
-		uint8_t flag;
-
-		if(blocks == 0)	{
-			blocks = 1;
-			flag = 0;
-		}
-		else {
-			if(inputLen & 0x000Fu)
-				flag = 0;
-			else
-				flag = 1;
-		}
-
-		for(uint8_t i = 0; i < BLOCK_SIZE_AES; ++i) {
-			output[i] = cmacInitVector[i];
-
-		}
-
-		Aes_p->chipher(output,output);
-
-		for(uint16_t msg = 0; msg < (uint16_t)(blocks - 1); ++msg) {
-			xor16byte(&input[msg << 4], output);
-			Aes_p->chipher(output,output);
-		}
-
-		if(flag) {
-			xor16byte(subkey1, output);
-			xor16byte(&input[(blocks-1) << 4], output);
-		}
-		else {
-			xor16byte(subkey2, output);
-			uint8_t extraBytes = inputLen & 0x000Fu;
-			for(uint8_t i = 0; i < BLOCK_SIZE_AES; ++i)	{
-				if(i < extraBytes)
-					output[i] ^= input[((blocks-1) << 4) + i];
-				else if(i == extraBytes)
-					output[i] ^= 0x80u;
-				else
-					output[i] ^= 0x00u;
-			}
+	/**
+	 * @brief	Check if prepareNextFrame() was called for the current key, EUI-64 and extPkgCnt
+	 */
+	bool isPrepared() const {
+		if (!preparedValid || preparedPkgCnt != extPkgCnt)
+			return false;
+		for(uint8_t i = 0; i < 8; ++i) {
+			if (preparedEui64[i] != eui64[i])
+				return false;
 		}
-		Aes_p->chipher(output,output);
+		return true;
 	}
 
-	void xor16byte(const uint8_t* const dataIn, uint8_t* const dataOut) const {
-		for(uint8_t i = 0; i < BLOCK_SIZE_AES; ++i)
-			dataOut[i] ^= dataIn[i];
+	/**
+	 * @brief	Expand the network key and generate the CMAC subkeys if the key has changed
+	 */
+	void prepareKey() {
+		if (keyScheduleValid)
+			return;
+		Cmac.setKey(networkKey);
+		keyScheduleValid = true;
 	}
 
-
-
 	/**
 	 * @brief Union for the MAC header format
 	 */
@@ -624,8 +655,26 @@ private:
 	//! MAC header storage
 	macHeader_t macHeader;
 
-	//! Pointer to instance of AES, actual instance is created on stack in the encode() method
-	TsUnb::Aes128 *Aes_p;
+	//! AES and CMAC subkeys of the network key, valid if keyScheduleValid is set
+	AesCmac Cmac;
+
+	//! Network key, private as changing it requires setNetworkKey() to invalidate the key schedule
+	uint8_t networkKey[16];
+
+	//! Cleared by setNetworkKey(), the key schedule is recalculated by prepareKey()
+	bool keyScheduleValid;
+
+	//! Encrypted CMAC initialization vector (block 0) and CTR keystream of the packet preparedPkgCnt, set by prepareNextFrame()
+	uint8_t preparedBlocks[(1 + TSUNB_MAC_PREPARED_BLOCKS) * BLOCK_SIZE_AES];
+
+	//! EUI-64 of the prepared blocks
+	uint8_t preparedEui64[8];
+
+	//! Packet counter of the prepared blocks
+	uint32_t preparedPkgCnt;
+
+	//! Set by prepareNextFrame(), cleared by encode() and setNetworkKey()
+	bool preparedValid;
 
 };
 
@@ -68,6 +68,9 @@ Am Wolfsmantel 33
 91058 Erlangen, Germany
 ks-contracts@iis.fraunhofer.de
 
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
 ----------------------------------------------------------------------------- */
 
 /**
@@ -91,6 +94,9 @@ ks-contracts@iis.fraunhofer.de
 #endif
 
 #include "../Utils/BitAccess.h"
+#include "../Utils/Crc8.h"
+#include "../Utils/ConvEncoder.h"
+#include "../Utils/BurstScatter.h"
 
 namespace TsUnbLib {
 namespace TsUnb {
@@ -106,6 +112,9 @@ namespace TsUnb {
 //! Additional overhead introduced by the PHY
 #define TSUNBPHY_OVERHEAD			4
 
+//! Maximum number of radio bursts, one per PSDU byte
+#define TSUNBPHY_MAX_NUM_BURSTS		(TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD)
+
 //! Position of header CRC
 #define TSUNBPHY_HEADER_CRC_POS		0
 
@@ -124,6 +133,47 @@ namespace TsUnb {
 //! Initialization vector of the 8 bit CRC
 #define TSUNBPHY_CRC8_INIT			0xFF
 
+//! Lookup table of the 8 bit CRC
+TSUNB_TABLE_ATTR inline const Crc8Table TSUNBPHY_CRC8_TABLE = makeCrc8Table<TSUNBPHY_CRC8_POLY>();
+
+//! Seed of the 9 bit whitening LFSR
+#define TSUNBPHY_WHITENING_SEED		0x1FF
+
+//! Length of the whitening sequence, i.e. the maximum PSDU length including the PHY overhead
+#define TSUNBPHY_WHITENING_LEN		(TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD)
+
+/**
+ * @brief Whitening sequence, wrapped into a struct to allow compile time generation
+ */
+struct TsUnbWhiteningSequence {
+	uint8_t entry[TSUNBPHY_WHITENING_LEN];	//!< Byte to XOR onto the PSDU byte with the same index
+};
+
+/**
+ * @brief Generate the whitening sequence at compile time
+ *
+ * The sequence is generated by the 9 bit LFSR x^9 + x^5 + 1 starting with the
+ * seed TSUNBPHY_WHITENING_SEED. The LFSR is clocked 8 times per byte.
+ *
+ * @return	Whitening sequence
+ */
+constexpr TsUnbWhiteningSequence makeWhiteningSequence() {
+	TsUnbWhiteningSequence seq = {};
+	uint16_t reg = TSUNBPHY_WHITENING_SEED;
+
+	for (uint16_t byte = 0; byte < TSUNBPHY_WHITENING_LEN; ++byte) {
+		for (uint8_t bit = 0; bit < 8; ++bit) {
+			reg <<= 1;
+			reg ^= 0x1 & (reg >> 9 ^ reg >> 4);
+		}
+		seq.entry[byte] = (uint8_t) reg;
+	}
+	return seq;
+}
+
+//! Whitening sequence for the longest possible PSDU
+TSUNB_TABLE_ATTR inline const TsUnbWhiteningSequence TSUNBPHY_WHITENING_SEQUENCE = makeWhiteningSequence();
+
 //! Polynomial of the 2 bit CRC
 #define TSUNBPHY_CRC2_POLY			0x03
 
@@ -145,6 +195,10 @@ namespace TsUnb {
 //! Polynomial G3 of the convolutional code g(x)=x^6 + x^4 + x^3 + x^2 + x + 1
 #define TSUNBPHY_CONV_POLY_G3		0x7D
 
+//! Lookup tables of the convolutional encoder
+TSUNB_TABLE_ATTR inline const ConvEncoderTables TSUNBPHY_CONV_TABLES =
+		makeConvEncoderTables<TSUNBPHY_CONV_POLY_G1, TSUNBPHY_CONV_POLY_G2, TSUNBPHY_CONV_POLY_G3>();
+
 //! Number of core bursts
 #define TSUNBPHY_NUM_CORE_BURSTS	24
 
@@ -179,6 +233,89 @@ enum TsUnbUPGMode {
 };
 
 
+//! Number of TSMA patterns in UPG3
+#define TSUNBPHY_UPG3_NUM_P			1
+
+/*
+ * Radio burst carrier sets C_RB and time sets T_RB of the TSMA uplink patterns according to 6.4.7.1.6.1.
+ * The tables are only evaluated at compile time, see Phy::TSMA_SCHEDULE.
+ */
+
+//! Carrier sequence of the TSMA uplink patterns of UPG1
+inline constexpr uint8_t TSUNBPHY_C_RB_UPG1[TSUNBPHY_UNB_NUM_P][TSUNBPHY_NUM_CORE_BURSTS] = {
+		{ 5, 21, 13,  6, 22, 14,  1, 17,  9,  0, 16,  8,  7, 23, 15,  4, 20, 12,  3, 19, 11,  2, 18, 10},
+		{ 4, 20, 12,  1, 17,  9,  0, 16,  8,  6, 22, 14,  7, 23, 15,  2, 18, 10,  5, 21, 13,  3, 19, 11},
+		{ 4, 20, 12,  3, 19, 11,  6, 22, 14,  7, 23, 15,  0, 16,  8,  5, 21, 13,  2, 18, 10,  1, 17,  9},
+		{ 6, 22, 14,  2, 18, 10,  7, 23, 15,  0, 16,  8,  1, 17,  9,  4, 20, 12,  5, 21, 13,  3, 19, 11},
+		{ 7, 23, 15,  4, 20, 12,  3, 19, 11,  2, 18, 10,  6, 22, 14,  0, 16,  8,  1, 17,  9,  5, 21, 13},
+		{ 3, 19, 11,  6, 22, 14,  2, 18, 10,  0, 16,  8,  7, 23, 15,  1, 17,  9,  4, 20, 12,  5, 21, 13},
+		{ 3, 19, 11,  1, 17,  9,  5, 21, 13,  7, 23, 15,  0, 16,  8,  2, 18, 10,  6, 22, 14,  4, 20, 12},
+		{ 0, 16,  8,  6, 22, 14,  3, 19, 11,  2, 18, 10,  4, 20, 12,  7, 23, 15,  5, 21, 13,  1, 17,  9}};
+
+//! Carrier sequence of the TSMA uplink patterns of UPG2
+inline constexpr uint8_t TSUNBPHY_C_RB_UPG2[TSUNBPHY_UNB_NUM_P][TSUNBPHY_NUM_CORE_BURSTS] = {
+		{ 4, 20, 12,  0, 16,  8,  3, 19, 11,  5, 21, 13,  1, 17,  9,  7, 23, 15,  2, 18, 10,  6, 22, 14},
+		{ 3, 19, 11,  7, 23, 15,  2, 18, 10,  5, 21, 13,  4, 20, 12,  0, 16,  8,  1, 17,  9,  6, 22, 14},
+		{ 6, 22, 14,  0, 16,  8,  1, 17,  9,  4, 20, 12,  3, 19, 11,  5, 21, 13,  2, 18, 10,  7, 23, 15},
+		{ 3, 19, 11,  1, 17,  9,  4, 20, 12,  5, 21, 13,  2, 18, 10,  7, 23, 15,  6, 22, 14,  0, 16,  8},
+		{ 5, 21, 13,  2, 18, 10,  0, 16,  8,  6, 22, 14,  7, 23, 15,  1, 17,  9,  4, 20, 12,  3, 19, 11},
+		{ 1, 17,  9,  3, 19, 11,  4, 20, 12,  6, 22, 14,  7, 23, 15,  5, 21, 13,  2, 18, 10,  0, 16,  8},
+		{ 5, 21, 13,  1, 17,  9,  2, 18, 10,  4, 20, 12,  3, 19, 11,  0, 16,  8,  6, 22, 14,  7, 23, 15},
+		{ 3, 19, 11,  6, 22, 14,  5, 21, 13,  1, 17,  9,  7, 23, 15,  2, 18, 10,  0, 16,  8,  4, 20, 12}};
+
+//! Carrier sequence of the TSMA uplink pattern of UPG3
+inline constexpr uint8_t TSUNBPHY_C_RB_UPG3[TSUNBPHY_UPG3_NUM_P][TSUNBPHY_NUM_CORE_BURSTS] = {
+		{ 1, 5, 4, 3, 2, 17, 21, 20, 19, 18, 9, 13, 12, 11, 10, 6, 0, 7, 22, 16, 23, 14, 8, 15}};
+
+/*
+ * The time sets of UPG1 are
+ * {{330, 387, 388, 330, 387, 354, 330, 387, 356, 330, 387, 432, 330, 387, 352, 330, 387, 467, 330, 387, 620, 330, 387},
+ *  {330, 387, 435, 330, 387, 409, 330, 387, 398, 330, 387, 370, 330, 387, 361, 330, 387, 472, 330, 387, 522, 330, 387},
+ *  {330, 387, 356, 330, 387, 439, 330, 387, 413, 330, 387, 352, 330, 387, 485, 330, 387, 397, 330, 387, 444, 330, 387},
+ *  {330, 387, 352, 330, 387, 382, 330, 387, 381, 330, 387, 365, 330, 387, 595, 330, 387, 604, 330, 387, 352, 330, 387},
+ *  {330, 387, 380, 330, 387, 634, 330, 387, 360, 330, 387, 393, 330, 387, 352, 330, 387, 373, 330, 387, 490, 330, 387},
+ *  {330, 387, 364, 330, 387, 375, 330, 387, 474, 330, 387, 355, 330, 387, 478, 330, 387, 464, 330, 387, 513, 330, 387},
+ *  {330, 387, 472, 330, 387, 546, 330, 387, 501, 330, 387, 356, 330, 387, 359, 330, 387, 359, 330, 387, 364, 330, 387},
+ *  {330, 387, 391, 330, 387, 468, 330, 387, 512, 330, 387, 543, 330, 387, 354, 330, 387, 391, 330, 387, 368, 330, 387}}
+ * and the ones of UPG2 are
+ * {{373, 319, 545, 373, 319, 443, 373, 319, 349, 373, 319, 454, 373, 319, 578, 373, 319, 436, 373, 319, 398, 373, 319},
+ *  {373, 319, 371, 373, 319, 410, 373, 319, 363, 373, 319, 354, 373, 319, 379, 373, 319, 657, 373, 319, 376, 373, 319},
+ *  {373, 319, 414, 373, 319, 502, 373, 319, 433, 373, 319, 540, 373, 319, 428, 373, 319, 467, 373, 319, 409, 373, 319},
+ *  {373, 319, 396, 373, 319, 516, 373, 319, 631, 373, 319, 471, 373, 319, 457, 373, 319, 416, 373, 319, 354, 373, 319},
+ *  {373, 319, 655, 373, 319, 416, 373, 319, 367, 373, 319, 400, 373, 319, 415, 373, 319, 342, 373, 319, 560, 373, 319},
+ *  {373, 319, 370, 373, 319, 451, 373, 319, 465, 373, 319, 593, 373, 319, 545, 373, 319, 380, 373, 319, 365, 373, 319},
+ *  {373, 319, 393, 373, 319, 374, 373, 319, 344, 373, 319, 353, 373, 319, 620, 373, 319, 503, 373, 319, 546, 373, 319},
+ *  {373, 319, 367, 373, 319, 346, 373, 319, 584, 373, 319, 579, 373, 319, 519, 373, 319, 351, 373, 319, 486, 373, 319}}
+ * For UPG1 and UPG2 only every 3rd position is different, so only these are stored.
+ */
+
+//! Time offset sequence for the non-identical delays of the TSMA uplink patterns of UPG1
+inline constexpr uint16_t TSUNBPHY_T_RB_UPG1[TSUNBPHY_UNB_NUM_P][(TSUNBPHY_NUM_CORE_BURSTS - 1) / 3] = {
+		{388, 354, 356, 432, 352, 467, 620},
+		{435, 409, 398, 370, 361, 472, 522},
+		{356, 439, 413, 352, 485, 397, 444},
+		{352, 382, 381, 365, 595, 604, 352},
+		{380, 634, 360, 393, 352, 373, 490},
+		{364, 375, 474, 355, 478, 464, 513},
+		{472, 546, 501, 356, 359, 359, 364},
+		{391, 468, 512, 543, 354, 391, 368}};
+
+//! Time offset sequence for the non-identical delays of the TSMA uplink patterns of UPG2
+inline constexpr uint16_t TSUNBPHY_T_RB_UPG2[TSUNBPHY_UNB_NUM_P][(TSUNBPHY_NUM_CORE_BURSTS - 1) / 3] = {
+		{545, 443, 349, 454, 578, 436, 398},
+		{371, 410, 363, 354, 379, 657, 376},
+		{414, 502, 433, 540, 428, 467, 409},
+		{396, 516, 631, 471, 457, 416, 354},
+		{655, 416, 367, 400, 415, 342, 560},
+		{370, 451, 465, 593, 545, 380, 365},
+		{393, 374, 344, 353, 620, 503, 546},
+		{367, 346, 584, 579, 519, 351, 486}};
+
+//! Time offset sequence of the TSMA uplink pattern of UPG3
+inline constexpr uint8_t TSUNBPHY_T_RB_UPG3[TSUNBPHY_UPG3_NUM_P][TSUNBPHY_NUM_CORE_BURSTS - 1] = {
+		{66, 66, 66, 66, 66, 66, 66, 66, 66, 123, 66, 66, 66, 66, 60, 66, 66, 198, 66, 66, 255, 66, 66}};
+
+
 /**
  * @brief Implementation of ETSI TS 103 357 TS-UNB Uplink Physical Layer (PHY)
  *
@@ -203,16 +340,34 @@ enum TsUnbUPGMode {
  * The template class RadioBurst_T defines a radio burst data structure. The actual implementation has to
  * offer the methods: uint16_t getBurstLength(void), uint8_t* getBurst(void), uint16_t get_channel(void).
  *
+ * The template parameter FIXED_MPDU_LENGTH is an optional MPDU length known at compile time. For this
+ * length the interleaver positions of all coded bits are stored in a constant scatter table. Other
+ * lengths are still supported, but use the slower runtime calculation. 0 disables the table.
+ *
  */
 template <uint32_t CHAN_A = 14224261, uint32_t CHAN_B = 14222623,
 		uint32_t B_c = 39, uint32_t B_c0 = 39, TsUnbUPGMode TSUNB_UPG = TsUnb_UPG1,
-		uint8_t MMODE =	0, uint8_t n_co = 3, class RadioBurst_T = TsUnb::RadioBurst <> >
+		uint8_t MMODE =	0, uint8_t n_co = 3, class RadioBurst_T = TsUnb::RadioBurst <>,
+		uint16_t FIXED_MPDU_LENGTH = 0>
 class Phy {
 
 public:
 	//! Type of the radio bursts
 	typedef RadioBurst_T RadioBurst_t;
 
+	//! Number of TSMA patterns of the uplink pattern group
+	static constexpr uint8_t NUM_TSMA_PATTERNS = TSUNB_UPG == TsUnb_UPG3 ? TSUNBPHY_UPG3_NUM_P : TSUNBPHY_UNB_NUM_P;
+
+	/**
+	 * @brief TSMA schedule of the core frame for a single TSMA pattern
+	 */
+	struct TsmaSchedule {
+		struct {
+			uint16_t carrierOffset;	//!< Carrier offset C_RB * B_c wrt. f_0 in transmitter register values
+			uint16_t T_RB;			//!< Time to the start of the next burst in symbols, 0 for the last burst
+		} burst[TSUNBPHY_NUM_CORE_BURSTS];	//!< Schedule of each core burst
+	};
+
 	/**
 	 * @brief Constructor, which is currently not used
 	 */
@@ -251,120 +406,79 @@ public:
 
 
 		/*
-		 * Copy data to local buffer and set fields
+		 * The PSDU is not copied to a local buffer. Its bytes, i.e. the PHY header,
+		 * the MPDU, the stuffing and the MMODE, are read from the MPDU one after another,
+		 * whitened, encoded and written onto the radio bursts in a single pass.
 		 */
-		uint8_t PhyPayload[numBursts];
-		for (uint16_t i = 0; i < MPDU_Length; ++i) {
-			PhyPayload[TSUNBPHY_PAYLOAD_DATA_POS + i] = MPDU[i];
-		}
-		PhyPayload[TSUNBPHY_PAYLOAD_PSI_POS] = (uint8_t) MPDU_Length;
-
-
-		// The MMODE is copied at the end of the payload data for CRC calculation.
-		// It is copied to the correct position if stuffing is required later.
-		PhyPayload[TSUNBPHY_PAYLOAD_DATA_POS + MPDU_Length] = MMODE << 6;
 
-		// Calculate the payload CRC
-		PhyPayload[TSUNBPHY_PAYLOAD_CRC_POS] =
-				calcCRC8(&PhyPayload[TSUNBPHY_PAYLOAD_DATA_POS], MPDU_Length * 8 + 2);
-
-
-		// Stuff in case of short PSDU and bring the MMODE to the right position
-		if (MPDU_Length < TSUNBPHY_MIN_PSDU_LENGTH) {
-			// We have to stuff the data
-			for (uint16_t i = MPDU_Length;i < TSUNBPHY_MIN_PSDU_LENGTH; ++i) {
-				PhyPayload[TSUNBPHY_PAYLOAD_DATA_POS + i] = 0;
-			}
-
-			// Finally copy the MMODE to the right position at the end of the stuffing data
-			PhyPayload[TSUNBPHY_PAYLOAD_DATA_POS + TSUNBPHY_MIN_PSDU_LENGTH] = MMODE << 6;
-		}
+		// Calculate the payload CRC including the two MMODE bits
+		uint8_t payloadCrc = calcCRC8(MPDU, MPDU_Length * 8);
+		payloadCrc = Crc8<TSUNBPHY_CRC8_TABLE>::updateBits(payloadCrc, MMODE << 6, 2);
 
 		// Calculate the header CRC
-		PhyPayload[TSUNBPHY_HEADER_CRC_POS] = calcCRC8(&PhyPayload[TSUNBPHY_PAYLOAD_CRC_POS], 16);
-
+		uint8_t header[TSUNBPHY_PAYLOAD_DATA_POS];
+		header[TSUNBPHY_PAYLOAD_CRC_POS] = payloadCrc;
+		header[TSUNBPHY_PAYLOAD_PSI_POS] = (uint8_t) MPDU_Length;
+		header[TSUNBPHY_HEADER_CRC_POS] = calcCRC8(&header[TSUNBPHY_PAYLOAD_CRC_POS], 16);
 
-		//! Payload CRC, later required as LFSR seed
-		const uint8_t payloadCrc = PhyPayload[TSUNBPHY_PAYLOAD_CRC_POS];
 
 		//! LFSR seed for burst positions in case of extension frame
 		uint16_t lfsrSeed =
-				0x8000u | (uint16_t) PhyPayload[TSUNBPHY_HEADER_CRC_POS] <<	8 | payloadCrc;
+				0x8000u | (uint16_t) header[TSUNBPHY_HEADER_CRC_POS] <<	8 | payloadCrc;
 
 
-		/*
-		 * Whiten the data
-		 */
-		whitenData(PhyPayload, numBursts);
-
 		/*
 		 * Do the convolutional encoding.
 		 * The coding is quite complex due to the bit shift in the interleaver.
 		 * To minimize memory consumption the interleaving and the convolutional
 		 * encoding are done in a single step.
 		 */
-		//! Number of payload bits
-		const uint16_t payloadBits = numBursts * 8;
-
-		//! Register for convolutional encoder
-		uint8_t convReg = 0;
-
-		// The code termination is achieved by means of the zero bits in the MMODE field.
-		// Therefore we have to restore our tail bits that we lost during the whitening.
-		PhyPayload[numBursts - 1] &= 0xC0;
-
-
+		//! Cyclic shift of the interleaver in input bytes of the convolutional encoder
+		const uint16_t shiftBytes = TSUNBPHY_NUM_BITS_SHIFT / TSUNBPHY_CONV_RATE / 8;
 
-		// To avoid an additional memory for the cylic shift of the interleaver we
-		// use some kind of tail biting covolutional code. For this purpose we
-		// first have to bring the code to the correct register state.
-		for (uint16_t inBitIdx = 0; inBitIdx < 8; ++inBitIdx) {
-			convReg <<= 1;
+		// The interleaver positions are either read from the scatter table (if the
+		// MPDU length is known at compile time) or calculated using counters
+		// The 24 data bits of each burst are collected in a 32 bit subpacket register
+		uint32_t subPacketBits[TSUNBPHY_MAX_NUM_BURSTS];
+		for (uint16_t burstIdx = 0; burstIdx < numBursts; ++burstIdx) {
+			subPacketBits[burstIdx] = 0;
+		}
 
-			const uint16_t shiftBitIdx = payloadBits + inBitIdx - (TSUNBPHY_NUM_BITS_SHIFT / 3 + 8);
-			if (readBit(shiftBitIdx, PhyPayload))
-				convReg |= 1;
+		const bool useScatterTable = FIXED_MPDU_LENGTH != 0 && MPDU_Length == FIXED_MPDU_LENGTH;
+		BurstScatter_t burstScatter(subPacketBits);
+		const BurstScatter_t* const scatter = useScatterTable ? &burstScatter : nullptr;
+		RadioBurstIdxCounter burstIdxCounter(numBursts);
+
+		// Due to the cyclic shift of the interleaver the first coded bits belong to the
+		// last input bytes. Therefore, we first encode these shiftBytes bytes, which only
+		// requires the byte in front of them to bring the encoder to the correct state.
+		ConvEncoder<TSUNBPHY_CONV_TABLES> convEncoder(
+				getPsduByte(header, MPDU, MPDU_Length, numBursts, numBursts - shiftBytes - 1));
+		for (uint16_t inByteIdx = 0; inByteIdx < shiftBytes; ++inByteIdx) {
+			const uint8_t psduByte = getPsduByte(header, MPDU, MPDU_Length, numBursts,
+					numBursts - shiftBytes + inByteIdx);
+			writeCodedBits(RadioBursts, subPacketBits, convEncoder.encodeByte(psduByte), inByteIdx,
+					scatter, burstIdxCounter);
 		}
 
-		// Here we to the actual convolutional encoding
+		// Here we to the actual convolutional encoding, 8 input bits per step
 		// We normally would have to reset the convolution encoder at the end
 		// of the payload data before starting to encode the initial header data,
 		// which is caused by the cyclic shift. However, the MMODE only takes 2 bits
 		// and we have 6 zeros in this byte. This actually terminates the code and
 		// we start again from zero.
-		for (uint16_t inBitIdx = 0; inBitIdx < payloadBits;	++inBitIdx) {
-
-			// Consider bit shift due to the interleaver and correct if necessary
-			int16_t shiftBitIdx = (int16_t) inBitIdx - TSUNBPHY_NUM_BITS_SHIFT / 3;
-			if (shiftBitIdx < 0)
-				shiftBitIdx += payloadBits;
-
-			convReg <<= 1;
-			if (readBit(shiftBitIdx, PhyPayload))
-				convReg |= 1;
-
-
-			// Get the one output from each branch of the convolutional encoder
-			uint8_t outBits[3];
-			outBits[0] = convEncode_parity(TSUNBPHY_CONV_POLY_G1 & convReg);
-			outBits[1] = convEncode_parity(TSUNBPHY_CONV_POLY_G2 & convReg);
-			outBits[2] = convEncode_parity(TSUNBPHY_CONV_POLY_G3 & convReg);
-
-			// And write the bits directly onto their correct positions on the radio bursts
-			for (uint8_t i = 0; i < 3; ++i) {
-				uint16_t outBitIdx = inBitIdx * 3 + i;
-				const uint16_t burstIdx = getRadioBurstIdx(outBitIdx, numBursts);
-				RadioBursts[burstIdx].writeSubPacketBit(outBits[i], burstIdx);
-			}
+		for (uint16_t psduIdx = 0; psduIdx < numBursts - shiftBytes; ++psduIdx) {
+			const uint8_t psduByte = getPsduByte(header, MPDU, MPDU_Length, numBursts, psduIdx);
+			writeCodedBits(RadioBursts, subPacketBits, convEncoder.encodeByte(psduByte), psduIdx + shiftBytes,
+					scatter, burstIdxCounter);
 		}
 
 
 		/*
-		 * Add the midamble and do the differntial MSK encoding
+		 * Write the data bits, add the midamble and do the differntial MSK encoding
 		 */
 		for (uint16_t burstIdx = 0; burstIdx < numBursts; ++burstIdx) {
-			RadioBursts[burstIdx].addMidamble(burstIdx);
-			RadioBursts[burstIdx].differentialMSKEncoding();
+			RadioBursts[burstIdx].commitSubPacket(burstIdx, subPacketBits[burstIdx]);
 		}
 
 
@@ -401,6 +515,18 @@ public:
 
 	}
 
+
+	/**
+	 * @brief Get the precomputed TSMA schedule of the core frame
+	 *
+	 * @param	TSMAPattern		TSMA pattern, caution: index starts with 0 (standard starts with 1)
+	 *
+	 * @return	TSMA schedule, the carrier offsets are already multiplied by B_c
+	 */
+	static const TsmaSchedule& getTsmaSchedule(const uint8_t TSMAPattern) {
+		return TSMA_SCHEDULE.pattern[TSMAPattern < NUM_TSMA_PATTERNS ? TSMAPattern : 0];
+	}
+
 	/** 
 	 * @brief Encoding of TS-UNB Sync Burst
 	 * 
@@ -471,7 +597,9 @@ private:
 	/**
 	 * @brief Calculation of CRC8
 	 *
-	 * This method implements a CRC8 calculation
+	 * This method implements a CRC8 calculation. Full bytes are processed using a
+	 * lookup table, a trailing incomplete byte (e.g. the MMODE bits) with a single
+	 * additional lookup.
 	 *
 	 * @param	inputBytes		Pointer to byte input memory
 	 * @param	numInputBits	Number of input bits for the calcuation of the CRC
@@ -480,66 +608,199 @@ private:
 	 *
 	 */
 	uint8_t calcCRC8(const uint8_t* const inputBytes, const uint16_t numInputBits) const {
-		//! CRC register, initialized with init state
-		uint8_t crc8_reg = TSUNBPHY_CRC8_INIT;
+		return Crc8<TSUNBPHY_CRC8_TABLE>::calc(TSUNBPHY_CRC8_INIT, inputBytes, numInputBits);
+	}
 
-		for (uint16_t bitIdx = 0; bitIdx < numInputBits; ++bitIdx) {
-			// Get msb
-			uint8_t msb = 0;
-			if (crc8_reg & 0x80)
-				msb = 1;
+	/**
+	 * @brief Get a whitened byte of the PSDU
+	 *
+	 * The PSDU consists of the PHY header, the MPDU, the stuffing for short MPDUs and
+	 * the MMODE. The byte is whitened using the precomputed whitening sequence. The
+	 * 6 zero bits following the MMODE are not whitened, as they terminate the code.
+	 *
+	 * @param	header		PHY header, i.e. the first TSUNBPHY_PAYLOAD_DATA_POS bytes
+	 * @param	MPDU		Pointer to MPDU input data
+	 * @param	MPDU_Length	MPDU length in bytes
+	 * @param	numBursts	Number of radio bursts, which equals the PSDU length in bytes
+	 * @param	psduIdx		Index of the byte in the PSDU
+	 *
+	 * @return	Whitened byte
+	 */
+	static uint8_t getPsduByte(const uint8_t* const header, const uint8_t* const MPDU,
+			const uint16_t MPDU_Length, const uint16_t numBursts, const uint16_t psduIdx) {
+		const uint8_t whitening = TSUNB_TABLE_READ_BYTE(TSUNBPHY_WHITENING_SEQUENCE.entry[psduIdx]);
+
+		if (psduIdx < TSUNBPHY_PAYLOAD_DATA_POS)
+			return header[psduIdx] ^ whitening;
+		if (psduIdx < TSUNBPHY_PAYLOAD_DATA_POS + MPDU_Length)
+			return MPDU[psduIdx - TSUNBPHY_PAYLOAD_DATA_POS] ^ whitening;
+		if (psduIdx == numBursts - 1)	// MMODE
+			return ((MMODE << 6) ^ whitening) & 0xC0;
+		return whitening;				// Stuffing
+	}
 
-			// Check if input bit set, if yes xor MSB
-			if (readBit(bitIdx, inputBytes))
-				msb ^= 1;
 
-			crc8_reg <<= 1;
 
-			if (msb)
-				crc8_reg ^= TSUNBPHY_CRC8_POLY;
+	/**
+	 * @brief Returns the radio burst of a coded bit according to the interleaver
+	 *
+	 * @param	bitIdx		Index of the coded bit
+	 * @param	numPackets	Number of radio bursts
+	 *
+	 * @return	Index of the radio burst
+	 */
+	static constexpr uint16_t getRadioBurstIdx(const uint16_t bitIdx, const uint16_t numPackets) {
+		if (bitIdx < TSUNBPHY_NUM_BITS_CORE_ILV) {	// Core frame (first 288 bit)
+			return bitIdx % TSUNBPHY_NUM_CORE_BURSTS;
 		}
+		else {		// Extension frame
+			uint16_t groupIdx = bitIdx - TSUNBPHY_NUM_BITS_CORE_ILV;
+			const uint16_t groupLen =
+					numPackets - (TSUNBPHY_NUM_CORE_BURSTS >> 1);
+
+			const uint16_t group = groupIdx / groupLen;
+			groupIdx -= group * groupLen;
 
-		return crc8_reg;
+			if (groupIdx < (TSUNBPHY_NUM_CORE_BURSTS >> 1))	// First 12 bit
+				return (groupIdx << 1) + (group & 1);
+			else
+				return groupIdx + (TSUNBPHY_NUM_CORE_BURSTS >> 1);
+		}
 	}
 
+
 	/**
-	 * @brief Whiten the transmit signal
-	 *
-	 * This method whitens the transmit signal
-	 *
-	 * @param	inputBytes		Pointer to input bytes
-	 * @param	numBytes		Number of input bytes
+	 * @brief Calculation of the radio burst indices of consecutive coded bits
 	 *
+	 * This class returns the same radio burst indices as getRadioBurstIdx() for the
+	 * coded bits 0, 1, 2, ... but uses counters instead of divisions, as the RP2040
+	 * has no hardware divider in the core.
 	 */
-	void whitenData(uint8_t* const inputBytes, const uint16_t numBytes) const {
-		uint16_t reg = 0x1FF;
+	class RadioBurstIdxCounter {
+	public:
+		/**
+		 * @brief Constructor
+		 *
+		 * @param	numPackets	Number of radio bursts
+		 */
+		RadioBurstIdxCounter(const uint16_t numPackets) :
+				coreBitsLeft(TSUNBPHY_NUM_BITS_CORE_ILV), coreIdx(0), groupIdx(0), groupOdd(0),
+				groupLen(numPackets - (TSUNBPHY_NUM_CORE_BURSTS >> 1)) {
+		}
+
+		/**
+		 * @brief Radio burst index of the next coded bit
+		 *
+		 * @return	Index of the radio burst
+		 */
+		uint16_t next() {
+			if (coreBitsLeft) {	// Core frame (first 288 bit)
+				--coreBitsLeft;
+				const uint16_t burstIdx = coreIdx;
+				if (++coreIdx == TSUNBPHY_NUM_CORE_BURSTS)
+					coreIdx = 0;
+				return burstIdx;
+			}
+
+			// Extension frame
+			uint16_t burstIdx;
+			if (groupIdx < (TSUNBPHY_NUM_CORE_BURSTS >> 1))	// First 12 bit
+				burstIdx = (groupIdx << 1) + groupOdd;
+			else
+				burstIdx = groupIdx + (TSUNBPHY_NUM_CORE_BURSTS >> 1);
 
-		for (uint16_t byte = 0; byte < numBytes; ++byte) {
-			for (uint8_t bit = 0; bit < 8; ++bit) {
-				reg <<= 1;
-				reg ^= 0x1 & (reg >> 9 ^ reg >> 4);
+			if (++groupIdx == groupLen) {
+				groupIdx = 0;
+				groupOdd ^= 1;
 			}
-			inputBytes[byte] ^= (uint8_t) reg;
+			return burstIdx;
 		}
-	}
 
+	private:
+		uint16_t coreBitsLeft;		//!< Remaining bits of the core frame
+		uint16_t coreIdx;			//!< Burst index within the core frame
+		uint16_t groupIdx;			//!< Bit index within the current extension group
+		uint16_t groupOdd;			//!< 1 for odd extension groups
+		const uint16_t groupLen;	//!< Length of an extension group
+	};
+
+
+	//! Entry of the scatter table, radio burst in the upper bits and the subpacket register bit in the lower bits
+	typedef uint16_t ScatterEntry_t;
+
+	//! Position of the burst index in a scatter table entry
+	static constexpr uint8_t SCATTER_BURST_SHIFT = 5;
+
+	//! Scatter of the coded bits using the scatter table, no hardware is claimed if there is no table
+	typedef typename SelectType<FIXED_MPDU_LENGTH != 0,
+			BurstScatter<ScatterEntry_t, SCATTER_BURST_SHIFT>,
+			SoftwareBurstScatter<ScatterEntry_t, SCATTER_BURST_SHIFT>>::type BurstScatter_t;
+
+	//! Number of radio bursts for FIXED_MPDU_LENGTH
+	static constexpr uint16_t FIXED_NUM_BURSTS = FIXED_MPDU_LENGTH < TSUNBPHY_MIN_PSDU_LENGTH ?
+			TSUNBPHY_MIN_PSDU_LENGTH + TSUNBPHY_OVERHEAD : FIXED_MPDU_LENGTH + TSUNBPHY_OVERHEAD;
+
+	//! Number of entries in the scatter table, a dummy entry if FIXED_MPDU_LENGTH is not used
+	static constexpr uint16_t SCATTER_TABLE_LEN = FIXED_MPDU_LENGTH != 0 ?
+			FIXED_NUM_BURSTS * TSUNB_RADIO_BURST_DATA_LEN : 1;
 
 	/**
-	 * @brief	Return parity of the input data
-	 *
-	 * @param	reg		Register value
+	 * @brief Scatter table, wrapped into a struct to allow compile time generation
+	 */
+	struct ScatterTable {
+		ScatterEntry_t entry[SCATTER_TABLE_LEN];	//!< Burst index and subpacket register bit of each coded bit
+	};
+
+	/**
+	 * @brief Generate the scatter table for FIXED_MPDU_LENGTH at compile time
 	 *
-	 * @return	Parity bit, i.e. 0 or 1
+	 * The register bit follows from the number of bits that have already been written to the same burst.
+	 * The entries are created by the scatter implementation which reads them.
 	 *
+	 * @return	Scatter table
 	 */
-	uint8_t convEncode_parity(uint8_t reg) const {
-		reg ^= reg >> 4;
-		reg ^= reg >> 2;
-		reg ^= reg >> 1;
+	static constexpr ScatterTable makeScatterTable() {
+		static_assert(FIXED_NUM_BURSTS <= BurstScatter_t::MAX_BURSTS, "FIXED_MPDU_LENGTH exceeds the scatter table entries");
+		ScatterTable t = {};
+		if (FIXED_MPDU_LENGTH == 0)
+			return t;
+
+		uint8_t slots[FIXED_NUM_BURSTS] = {};
+		for (uint16_t bitIdx = 0; bitIdx < SCATTER_TABLE_LEN; ++bitIdx) {
+			const uint16_t burstIdx = getRadioBurstIdx(bitIdx, FIXED_NUM_BURSTS);
+			t.entry[bitIdx] = BurstScatter_t::makeEntry(burstIdx,
+					RadioBurst_T::getSubPkgRegBit(burstIdx, slots[burstIdx]++));
+		}
+		return t;
+	}
+
+	//! Scatter table for FIXED_MPDU_LENGTH
+	static constexpr ScatterTable SCATTER_TABLE = makeScatterTable();
 
-		return reg & 1;
+	/**
+	 * @brief Write 24 coded bits onto their positions on the radio bursts
+	 *
+	 * @param	RadioBursts			Radio bursts
+	 * @param	subPacketBits		Subpacket registers of the radio bursts
+	 * @param	codedBits			Output of the convolutional encoder, first bit in bit 23
+	 * @param	inByteIdx			Index of the encoder step, i.e. the coded bits start at inByteIdx * 24
+	 * @param	scatter				Scatter using the table, nullptr to use the counter
+	 * @param	burstIdxCounter		Counter for the radio burst indices
+	 */
+	static void writeCodedBits(RadioBurst_T* const RadioBursts, uint32_t* const subPacketBits, const uint32_t codedBits,
+			const uint16_t inByteIdx, const BurstScatter_t* const scatter, RadioBurstIdxCounter& burstIdxCounter) {
+		if (scatter) {
+			scatter->write24(&SCATTER_TABLE.entry[inByteIdx * 24], codedBits);
+		}
+		else {
+			for (uint8_t i = 0; i < 24; ++i) {
+				const uint16_t burstIdx = burstIdxCounter.next();
+				RadioBursts[burstIdx].writeSubPacketBit((codedBits >> (23 - i)) & 1, burstIdx, subPacketBits[burstIdx]);
+			}
+		}
 	}
 
+
 	/**
 	 * @brief Calculate LFSR for TSMA pattern
 	 *
@@ -559,26 +820,6 @@ private:
 	}
 
 
-	uint16_t getRadioBurstIdx(const uint16_t bitIdx, const uint16_t numPackets) const {
-		if (bitIdx < TSUNBPHY_NUM_BITS_CORE_ILV) {	// Core frame (first 288 bit)
-			return bitIdx % TSUNBPHY_NUM_CORE_BURSTS;
-		}
-		else {		// Extension frame
-			uint16_t groupIdx = bitIdx - TSUNBPHY_NUM_BITS_CORE_ILV;
-			const uint16_t groupLen =
-					numPackets - (TSUNBPHY_NUM_CORE_BURSTS >> 1);
-
-			const uint16_t group = groupIdx / groupLen;
-			groupIdx -= group * groupLen;
-
-			if (groupIdx < (TSUNBPHY_NUM_CORE_BURSTS >> 1))	// First 12 bit
-				return (groupIdx << 1) + (group & 1);
-			else
-				return groupIdx + (TSUNBPHY_NUM_CORE_BURSTS >> 1);
-		}
-	}
-
-
 	/**
 	 * @brief Add the TSMA pattern to the radio bursts
 	 *
@@ -594,34 +835,21 @@ private:
 	void addTsmaPattern(const uint16_t numBursts, const uint8_t TSMAPattern,
 			uint16_t lfsrSeed, RadioBurst_T* const RadioBursts) const {
 
+		// The core frame is copied from the precomputed schedule. The T_RB of the
+		// last core burst is 0 and overwritten below in case of an extension frame.
+		const TsmaSchedule& schedule = getTsmaSchedule(TSMAPattern);
 		for (uint16_t i = 0; i < TSUNBPHY_NUM_CORE_BURSTS; ++i) {
-			RadioBursts[i].setCarrierOffset((uint16_t)get_C_RB(TSMAPattern, i) * B_c);
-
-			if (i != TSUNBPHY_NUM_CORE_BURSTS - 1)
-				RadioBursts[i].set_T_RB(get_T_RB(TSMAPattern, i));
+			RadioBursts[i].setCarrierOffset(schedule.burst[i].carrierOffset);
+			RadioBursts[i].set_T_RB(schedule.burst[i].T_RB);
 		}
 
 
+		const uint16_t extentionFrameTimeSpacing = TSUNB_UPG == TsUnb_UPG1 ? TSUNBPHY_TIME_SPACING_UPG1 :
+				(TSUNB_UPG == TsUnb_UPG2 ? TSUNBPHY_TIME_SPACING_UPG2 : TSUNBPHY_TIME_SPACING_UPG3);
+
 		for (uint16_t i = TSUNBPHY_NUM_CORE_BURSTS; i < numBursts; ++i) {
 			lfsrSeed = tsmaLfsr(lfsrSeed);
 			RadioBursts[i].setCarrierOffset(((lfsrSeed >> 8) % 25) * B_c);
-
-			uint16_t extentionFrameTimeSpacing;
-
-			switch (TSUNB_UPG) {
-			case TsUnb_UPG1:
-				extentionFrameTimeSpacing =	TSUNBPHY_TIME_SPACING_UPG1;
-				break;
-
-			case TsUnb_UPG2:
-				extentionFrameTimeSpacing =	TSUNBPHY_TIME_SPACING_UPG2;
-				break;
-
-			case TsUnb_UPG3:
-				extentionFrameTimeSpacing =	TSUNBPHY_TIME_SPACING_UPG3;
-				break;
-			}
-
 			RadioBursts[i -	1].set_T_RB(extentionFrameTimeSpacing +	(lfsrSeed % 128));
 		}
 
@@ -667,117 +895,37 @@ private:
 	 * @return	Radio burst time set T_RB
 	 *
 	 */
-	uint16_t get_T_RB(const uint8_t TSMAPattern, const uint16_t burstIdx) const {
+	static constexpr uint16_t get_T_RB(const uint8_t TSMAPattern, const uint16_t burstIdx) {
 		// Just to be sure
-		if (burstIdx >= 24)
+		if (burstIdx >= TSUNBPHY_NUM_CORE_BURSTS - 1)
 			return 0;
-		if (TSMAPattern >= 8)
+		if (TSMAPattern >= NUM_TSMA_PATTERNS)
 			return 0;
 
 		switch (TSUNB_UPG) {
-		case TsUnb_UPG1:{
-			// We use this uplink pattern
-			//{{330, 387, 388, 330, 387, 354, 330, 387, 356, 330, 387, 432, 330, 387, 352, 330, 387, 467, 330, 387, 620, 330, 387},
-			//{330, 387, 435, 330, 387, 409, 330, 387, 398, 330, 387, 370, 330, 387, 361, 330, 387, 472, 330, 387, 522, 330, 387},
-			//{330, 387, 356, 330, 387, 439, 330, 387, 413, 330, 387, 352, 330, 387, 485, 330, 387, 397, 330, 387, 444, 330, 387},
-			//{330, 387, 352, 330, 387, 382, 330, 387, 381, 330, 387, 365, 330, 387, 595, 330, 387, 604, 330, 387, 352, 330, 387},
-			//{330, 387, 380, 330, 387, 634, 330, 387, 360, 330, 387, 393, 330, 387, 352, 330, 387, 373, 330, 387, 490, 330, 387},
-			//{330, 387, 364, 330, 387, 375, 330, 387, 474, 330, 387, 355, 330, 387, 478, 330, 387, 464, 330, 387, 513, 330, 387},
-			//{330, 387, 472, 330, 387, 546, 330, 387, 501, 330, 387, 356, 330, 387, 359, 330, 387, 359, 330, 387, 364, 330, 387},
-			//{330, 387, 391, 330, 387, 468, 330, 387, 512, 330, 387, 543, 330, 387, 354, 330, 387, 391, 330, 387, 368, 330, 387}}
-
+		case TsUnb_UPG1:
 			// For the TSMA uplink patterns only every 3rd position is different
-			const uint8_t burstIdxMod = ((uint8_t)burstIdx) % 3;
-			switch (burstIdxMod) {
+			switch (burstIdx % 3) {
 			case 0:
 				return 330;
 			case 1:
 				return 387;
-			case 2:
-				// Here we store the coefficients for every third position	
-				typedef uint16_t ETSI_TS_UNB_TRB_t[(TSUNBPHY_NUM_CORE_BURSTS - 1) / 3];
-				//! Time offset sequence for the non-identical delays of the TSMA uplink pattern of UPG1
-				const
-#ifdef __AVR_ARCH__
-						static PROGMEM
-#endif
-						ETSI_TS_UNB_TRB_t ETSI_TS_UNB_TRB_UPG1[TSUNBPHY_UNB_NUM_P] = {
-								{388, 354, 356, 432, 352, 467, 620},
-								{435, 409, 398, 370, 361, 472, 522},
-								{356, 439, 413, 352, 485, 397, 444},
-								{352, 382, 381, 365, 595, 604, 352},
-								{380, 634, 360, 393, 352, 373, 490},
-								{364, 375, 474, 355, 478, 464, 513},
-								{472, 546, 501, 356, 359, 359, 364},
-								{391, 468, 512, 543, 354, 391, 368}};
-
-#ifdef __AVR_ARCH__
-				return (uint16_t)pgm_read_word(&(ETSI_TS_UNB_TRB_UPG1[TSMAPattern][(uint8_t)burstIdx / 3]));
-#else
-				return ETSI_TS_UNB_TRB_UPG1[TSMAPattern][burstIdx / 3];
-#endif
+			default:
+				return TSUNBPHY_T_RB_UPG1[TSMAPattern][burstIdx / 3];
 			}
-		} break; 	// TsUnb_UPG1
-
-		case TsUnb_UPG2: {
-			// We use this uplink pattern
-			//{{373, 319, 545, 373, 319, 443, 373, 319, 349, 373, 319, 454, 373, 319, 578, 373, 319, 436, 373, 319, 398, 373, 319},
-			//{373, 319, 371, 373, 319, 410, 373, 319, 363, 373, 319, 354, 373, 319, 379, 373, 319, 657, 373, 319, 376, 373, 319},
-			//{373, 319, 414, 373, 319, 502, 373, 319, 433, 373, 319, 540, 373, 319, 428, 373, 319, 467, 373, 319, 409, 373, 319},
-			//{373, 319, 396, 373, 319, 516, 373, 319, 631, 373, 319, 471, 373, 319, 457, 373, 319, 416, 373, 319, 354, 373, 319},
-			//{373, 319, 655, 373, 319, 416, 373, 319, 367, 373, 319, 400, 373, 319, 415, 373, 319, 342, 373, 319, 560, 373, 319},
-			//{373, 319, 370, 373, 319, 451, 373, 319, 465, 373, 319, 593, 373, 319, 545, 373, 319, 380, 373, 319, 365, 373, 319},
-			//{373, 319, 393, 373, 319, 374, 373, 319, 344, 373, 319, 353, 373, 319, 620, 373, 319, 503, 373, 319, 546, 373, 319},
-			//{373, 319, 367, 373, 319, 346, 373, 319, 584, 373, 319, 579, 373, 319, 519, 373, 319, 351, 373, 319, 486, 373, 319}}
-			const uint8_t burstIdxMod = ((uint8_t)burstIdx) % 3;
-			switch (burstIdxMod) {
+
+		case TsUnb_UPG2:
+			switch (burstIdx % 3) {
 			case 0:
 				return 373;
 			case 1:
 				return 319;
-			case 2:
-				// Here we store the coefficients for every third position	
-				typedef uint16_t ETSI_TS_UNB_TRB_t[(TSUNBPHY_NUM_CORE_BURSTS - 1) / 3];
-				//! Time offset sequence for the non-identical delays of the TSMA uplink pattern of UPG2
-				const
-#ifdef __AVR_ARCH__
-						static PROGMEM
-#endif
-						ETSI_TS_UNB_TRB_t ETSI_TS_UNB_TRB_UPG2[TSUNBPHY_UNB_NUM_P] = {
-								{545, 443, 349, 454, 578, 436, 398},
-								{371, 410, 363, 354, 379, 657, 376},
-								{414, 502, 433, 540, 428, 467, 409},
-								{396, 516, 631, 471, 457, 416, 354},
-								{655, 416, 367, 400, 415, 342, 560},
-								{370, 451, 465, 593, 545, 380, 365},
-								{393, 374, 344, 353, 620, 503, 546},
-								{367, 346, 584, 579, 519, 351, 486}};
-
-#ifdef __AVR_ARCH__
-				return (uint16_t)pgm_read_word(&(ETSI_TS_UNB_TRB_UPG2[TSMAPattern][burstIdx / 3]));
-#else
-				return ETSI_TS_UNB_TRB_UPG2[TSMAPattern][burstIdx / 3];
-#endif
+			default:
+				return TSUNBPHY_T_RB_UPG2[TSMAPattern][burstIdx / 3];
 			}
-		} break;	// TsUnb_UPG2
-
-		case TsUnb_UPG3: {
-			typedef uint8_t ETSI_TS_UNB_TRB_t[TSUNBPHY_NUM_CORE_BURSTS - 1];
-			//! Time offset sequence of the TSMA uplink pattern of UPG3
-			const
-#ifdef __AVR_ARCH__
-					static PROGMEM
-#endif
-					ETSI_TS_UNB_TRB_t ETSI_TS_UNB_TRB_UPG3[1] = {
-							{66, 66, 66, 66, 66, 66, 66, 66, 66, 123, 66, 66, 66, 66, 60, 66, 66, 198, 66, 66, 255, 66, 66}
-			};
 
-#ifdef __AVR_ARCH__
-			return (uint16_t)pgm_read_byte(&(ETSI_TS_UNB_TRB_UPG3[0][burstIdx]));
-#else
-			return ETSI_TS_UNB_TRB_UPG3[0][burstIdx];
-#endif
-		} break;	// TsUnb_UPG3
+		case TsUnb_UPG3:
+			return TSUNBPHY_T_RB_UPG3[TSMAPattern][burstIdx];
 		}
 
 		return 0;	// We should normally never reach this point
@@ -794,75 +942,53 @@ private:
 	 * @return	Radio burst time set C_RB
 	 *
 	 */
-	uint8_t get_C_RB(const uint8_t TSMAPattern, const uint16_t burstIdx) const {
-		typedef uint8_t ETSI_TS_UNB_CRB_t[TSUNBPHY_NUM_CORE_BURSTS];
+	static constexpr uint8_t get_C_RB(const uint8_t TSMAPattern, const uint16_t burstIdx) {
+		// Just to be sure
+		if (burstIdx >= TSUNBPHY_NUM_CORE_BURSTS)
+			return 0;
+		if (TSMAPattern >= NUM_TSMA_PATTERNS)
+			return 0;
 
 		switch (TSUNB_UPG) {
-		case TsUnb_UPG1: {
-			//! Carrier sequence of the TSMA uplink pattern of UPG1
-			const
-#ifdef __AVR_ARCH__
-		static PROGMEM
-#endif
-		ETSI_TS_UNB_CRB_t ETSI_TS_UNB_CRB_UPG1[TSUNBPHY_UNB_NUM_P] = {
-				{ 5, 21, 13,  6, 22, 14,  1, 17,  9,  0, 16,  8,  7, 23, 15,  4, 20, 12,  3, 19, 11,  2, 18, 10},
-				{ 4, 20, 12,  1, 17,  9,  0, 16,  8,  6, 22, 14,  7, 23, 15,  2, 18, 10,  5, 21, 13,  3, 19, 11},
-				{ 4, 20, 12,  3, 19, 11,  6, 22, 14,  7, 23, 15,  0, 16,  8,  5, 21, 13,  2, 18, 10,  1, 17,  9},
-				{ 6, 22, 14,  2, 18, 10,  7, 23, 15,  0, 16,  8,  1, 17,  9,  4, 20, 12,  5, 21, 13,  3, 19, 11},
-				{ 7, 23, 15,  4, 20, 12,  3, 19, 11,  2, 18, 10,  6, 22, 14,  0, 16,  8,  1, 17,  9,  5, 21, 13},
-				{ 3, 19, 11,  6, 22, 14,  2, 18, 10,  0, 16,  8,  7, 23, 15,  1, 17,  9,  4, 20, 12,  5, 21, 13},
-				{ 3, 19, 11,  1, 17,  9,  5, 21, 13,  7, 23, 15,  0, 16,  8,  2, 18, 10,  6, 22, 14,  4, 20, 12},
-				{ 0, 16,  8,  6, 22, 14,  3, 19, 11,  2, 18, 10,  4, 20, 12,  7, 23, 15,  5, 21, 13,  1, 17,  9}};
+		case TsUnb_UPG1:
+			return TSUNBPHY_C_RB_UPG1[TSMAPattern][burstIdx];
 
-#ifdef __AVR_ARCH__
-			return (uint8_t)pgm_read_byte(&(ETSI_TS_UNB_CRB_UPG1[TSMAPattern][burstIdx]));
-#else
-			return ETSI_TS_UNB_CRB_UPG1[TSMAPattern][burstIdx];
-#endif
-		} break; 	// TsUnb_UPG1
+		case TsUnb_UPG2:
+			return TSUNBPHY_C_RB_UPG2[TSMAPattern][burstIdx];
 
-		case TsUnb_UPG2: {
-			//! Carrier sequence of the TSMA uplink pattern of UPG2
-			const
-#ifdef __AVR_ARCH__
-		static PROGMEM
-#endif
-		ETSI_TS_UNB_CRB_t ETSI_TS_UNB_CRB_UPG2[TSUNBPHY_UNB_NUM_P] = {
-				{ 4, 20, 12,  0, 16,  8,  3, 19, 11,  5, 21, 13,  1, 17,  9,  7, 23, 15,  2, 18, 10,  6, 22, 14},
-				{ 3, 19, 11,  7, 23, 15,  2, 18, 10,  5, 21, 13,  4, 20, 12,  0, 16,  8,  1, 17,  9,  6, 22, 14},
-				{ 6, 22, 14,  0, 16,  8,  1, 17,  9,  4, 20, 12,  3, 19, 11,  5, 21, 13,  2, 18, 10,  7, 23, 15},
-				{ 3, 19, 11,  1, 17,  9,  4, 20, 12,  5, 21, 13,  2, 18, 10,  7, 23, 15,  6, 22, 14,  0, 16,  8},
-				{ 5, 21, 13,  2, 18, 10,  0, 16,  8,  6, 22, 14,  7, 23, 15,  1, 17,  9,  4, 20, 12,  3, 19, 11},
-				{ 1, 17,  9,  3, 19, 11,  4, 20, 12,  6, 22, 14,  7, 23, 15,  5, 21, 13,  2, 18, 10,  0, 16,  8},
-				{ 5, 21, 13,  1, 17,  9,  2, 18, 10,  4, 20, 12,  3, 19, 11,  0, 16,  8,  6, 22, 14,  7, 23, 15},
-				{ 3, 19, 11,  6, 22, 14,  5, 21, 13,  1, 17,  9,  7, 23, 15,  2, 18, 10,  0, 16,  8,  4, 20, 12}};
+		case TsUnb_UPG3:
+			return TSUNBPHY_C_RB_UPG3[TSMAPattern][burstIdx];
+		}
 
-#ifdef __AVR_ARCH__
-			return (uint8_t)pgm_read_byte(&(ETSI_TS_UNB_CRB_UPG2[TSMAPattern][burstIdx]));
-#else
-			return ETSI_TS_UNB_CRB_UPG2[TSMAPattern][burstIdx];
-#endif
-		} break;	// TsUnb_UPG2
+		return 0;	// We should normally never reach this point
+	}
 
-		case TsUnb_UPG3: {
-			//! Carrier sequence of the TSMA uplink pattern of UPG3
-			const
-#ifdef __AVR_ARCH__
-		static PROGMEM
-#endif
-		ETSI_TS_UNB_CRB_t ETSI_TS_UNB_CRB_UPG3[1] = {
-				{ 1, 5, 4, 3, 2, 17, 21, 20, 19, 18, 9, 13, 12, 11, 10, 6, 0, 7, 22, 16, 23, 14, 8, 15}};
 
-#ifdef __AVR_ARCH__
-			return (uint8_t)pgm_read_byte(&(ETSI_TS_UNB_CRB_UPG3[0][burstIdx]));
-#else
-			return ETSI_TS_UNB_CRB_UPG3[0][burstIdx];
-#endif
-		} break;	// TsUnb_UPG3
-		}
+	/**
+	 * @brief TSMA schedule of all patterns, wrapped into a struct to allow compile time generation
+	 */
+	struct TsmaScheduleTable {
+		TsmaSchedule pattern[NUM_TSMA_PATTERNS];	//!< Schedule of each TSMA pattern
+	};
 
-		return 0;	// We should normally never reach this point
+	/**
+	 * @brief Generate the TSMA schedules of the uplink pattern group at compile time
+	 *
+	 * @return	TSMA schedules
+	 */
+	static constexpr TsmaScheduleTable makeTsmaScheduleTable() {
+		TsmaScheduleTable t = {};
+		for (uint8_t p = 0; p < NUM_TSMA_PATTERNS; ++p) {
+			for (uint16_t i = 0; i < TSUNBPHY_NUM_CORE_BURSTS; ++i) {
+				t.pattern[p].burst[i].carrierOffset = (uint16_t) (get_C_RB(p, i) * B_c);
+				t.pattern[p].burst[i].T_RB = get_T_RB(p, i);
+			}
+		}
+		return t;
 	}
+
+	//! TSMA schedules of the uplink pattern group with the carrier offsets in transmitter register values
+	static constexpr TsmaScheduleTable TSMA_SCHEDULE = makeTsmaScheduleTable();
 };
 
 };	// namespace TsUnb
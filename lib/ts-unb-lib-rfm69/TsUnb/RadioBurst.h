@@ -68,6 +68,9 @@ Am Wolfsmantel 33
 91058 Erlangen, Germany
 ks-contracts@iis.fraunhofer.de
 
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
 ----------------------------------------------------------------------------- */
 
 
@@ -89,6 +92,7 @@ ks-contracts@iis.fraunhofer.de
 #include <inttypes.h>
 
 #include "../Utils/BitAccess.h"
+#include "../Utils/CodeMemory.h"
 
 namespace TsUnbLib {
 namespace TsUnb {
@@ -105,6 +109,12 @@ namespace TsUnb {
 //! Number of data symbols for one TS-UNB radio burst
 #define TSUNB_RADIO_BURST_DATA_LEN		24
 
+//! Midamble of the core bursts, first symbol in the MSB
+#define TSUNB_RADIO_BURST_MIDAMBLE_CORE	0x742
+
+//! Midamble of the extension bursts, first symbol in the MSB
+#define TSUNB_RADIO_BURST_MIDAMBLE_EXT	0x4FA
+
 
 /**
  * @brief	Implementation of Radio Bursts
@@ -132,6 +142,9 @@ public:
 	//! total length of radio burst in bytes
 	static const uint16_t BURST_LENGTH_BYTES = (BURST_LENGTH + 7) / 8;
 
+	//! Length of the frequency register image in bytes
+	static const uint16_t FREQUENCY_REG_BYTES = 3;
+
 	/**
 	 * @brief Constructor
 	 *
@@ -143,6 +156,9 @@ public:
 		for (uint16_t i = 0; i < BURST_LENGTH_BYTES; ++i) {
 			data[i] = 0;
 		}
+		for (uint16_t i = 0; i < FREQUENCY_REG_BYTES; ++i) {
+			frequencyReg[i] = 0;
+		}
 	}
 
 	/**
@@ -151,7 +167,7 @@ public:
 	 * @return	Length of radio burst in bits
 	 *
 	 */
-	uint16_t getBurstLength(void) const {
+	TSUNB_TIME_CRITICAL_INLINE uint16_t getBurstLength(void) const {
 		if (carrierOffset != 0xFFFF)
 			return BURST_LENGTH;
 		else
@@ -178,7 +194,7 @@ public:
 	 * @return 	Pointer to radio burst data
 	 *
 	 */
-	const uint8_t* getBurst(void) const {
+	TSUNB_TIME_CRITICAL_INLINE const uint8_t* getBurst(void) const {
 		return data;
 	}
 
@@ -186,21 +202,74 @@ public:
 	/**
 	 * @brief	Write bit to subpacket
 	 *
-	 * This method writes a bit to the correct position (includes interleaving) 
-	 * in the subpacket and increases its internal index.
+	 * This method writes a bit to the correct position (includes interleaving)
+	 * in the subpacket register of this burst and increases its internal index.
+	 * The register is kept by the encoder and only written to the burst data by
+	 * commitSubPacket().
 	 * Caution: This counter value is also used for T_RB. After writing
 	 * the value T_RB the method writeSubPacketBit() can no longer be used.
 	 *
-	 * @param	bit			Value of the bit, i.e. 0 or 1
-	 * @param	burstIdx	Number of this radio burst in radio burst structure
+	 * @param	bit				Value of the bit, i.e. 0 or 1
+	 * @param	burstIdx		Number of this radio burst in radio burst structure
+	 * @param	subPacketBits	Subpacket register of this burst, initially 0
 	 *
 	 */
-	void writeSubPacketBit(const uint8_t bit, const uint16_t burstIdx) {
-		uint16_t bitIdx = getSubPkgBitIdx(burstIdx, T_RB);
-		writeBit(bit, bitIdx + HEAD_BITS, data);
+	void writeSubPacketBit(const uint8_t bit, const uint16_t burstIdx, uint32_t& subPacketBits) {
+		subPacketBits |= (uint32_t) bit << getSubPkgRegBit(burstIdx, T_RB);
 		T_RB++;
 	}
 
+	/**
+	 * @brief Function to calculate the position of a bit in the subpacket register
+	 *
+	 * This is the position of getSubPkgBitIdx() within the 32 bit subpacket register
+	 * that collects the data bits until commitSubPacket() is called. Bits 23 to 12 of
+	 * the register hold the burst symbols 0 to 11, bits 11 to 0 the symbols 24 to 35.
+	 *
+	 * @param	burstIdx	Index of the radio burst
+	 * @param	bitIdx		Index of the bit within the burst
+	 *
+	 * @return	Position of the bit within the register (0 to 23)
+	 */
+	static constexpr uint8_t getSubPkgRegBit(const uint16_t burstIdx, const uint8_t bitIdx) {
+		return ((burstIdx ^ bitIdx) & 1) ?
+				11 - (bitIdx >> 1) :	// symbol 24 + (bitIdx >> 1)
+				12 + (bitIdx >> 1);		// symbol 11 - (bitIdx >> 1)
+	}
+
+	/**
+	 * @brief	Write the collected subpacket bits, the midamble and do the differential encoding
+	 *
+	 * This method has to be called after all 24 bits have been written to the subpacket
+	 * register. It assembles the complete burst in a register and writes it once to the
+	 * burst data, which replaces addMidamble() followed by differentialMSKEncoding().
+	 *
+	 * @param	burstIdx		Number of this radio burst in radio burst structure
+	 * @param	subPacketBits	Subpacket register, see getSubPkgRegBit()
+	 */
+	void commitSubPacket(const uint16_t burstIdx, const uint32_t subPacketBits) {
+		static_assert(BURST_LENGTH_BYTES <= 8, "Radio burst does not fit into 64 bit register");
+
+		// The 36 burst symbols, first symbol in the MSB
+		const uint32_t midamble = burstIdx < TSUNB_RADIO_BURST_CORE_BURSTS ?
+				TSUNB_RADIO_BURST_MIDAMBLE_CORE : TSUNB_RADIO_BURST_MIDAMBLE_EXT;
+		const uint64_t symbols = (uint64_t) (subPacketBits & 0xFFF000) << 12
+				| (uint64_t) midamble << 12 | (subPacketBits & 0xFFF);
+
+		// Add the zero head and tail bits and do the differential encoding
+		uint64_t burst = symbols << (BURST_LENGTH_BYTES * 8 - HEAD_BITS - TSUNB_RADIO_BURST_PAYLOAD_LEN);
+		burst ^= burst >> 1;
+
+		// The first and last two bits of each burst are don't cares
+		// Setting at least one initial bit to 1 is a workaround
+		if (HEAD_BITS > 0)
+			burst |= (uint64_t) 1 << (BURST_LENGTH_BYTES * 8 - 1);
+
+		for (uint16_t i = 0; i < BURST_LENGTH_BYTES; ++i) {
+			data[i] = (uint8_t) (burst >> ((BURST_LENGTH_BYTES - 1 - i) * 8));
+		}
+	}
+
 	/**
 	 * @brief	Write bit to subpacket at position Idx
 	 *
@@ -241,7 +310,7 @@ public:
 	 * @return	Time T_RB
 	 *
 	 */
-	uint16_t get_T_RB() const {
+	TSUNB_TIME_CRITICAL_INLINE uint16_t get_T_RB() const {
 		return T_RB;
 	}
 
@@ -273,6 +342,36 @@ public:
 		return carrierOffset;
 	}
 
+
+	/**
+	 * @brief	Set the frequency register image of the radio burst
+	 *
+	 * This method stores the transmitter register value of the burst frequency, i.e.
+	 * f_0 plus the carrier offset, with the most significant byte first. It is called
+	 * after the encoding and after setting the carrier offset, so that the transmitter
+	 * only has to copy the bytes while the burst timing is running.
+	 *
+	 * @param	f0		Frequency f_0 in TX register values, as returned by the PHY encoding
+	 *
+	 */
+	void setFrequencyReg(const uint32_t f0) {
+		const uint32_t frequency = f0 + (uint32_t) carrierOffset;
+		for (uint16_t i = 0; i < FREQUENCY_REG_BYTES; ++i) {
+			frequencyReg[i] = (uint8_t) (frequency >> ((FREQUENCY_REG_BYTES - 1 - i) * 8));
+		}
+	}
+
+
+	/**
+	 * @brief	Get the frequency register image of the radio burst
+	 *
+	 * @return	Pointer to the FREQUENCY_REG_BYTES bytes set by setFrequencyReg(), most significant byte first
+	 *
+	 */
+	const uint8_t* getFrequencyReg(void) const {
+		return frequencyReg;
+	}
+
 	/**
 	 * @brief	Add the midamble to the radio burst
 	 *
@@ -351,6 +450,9 @@ private:
 	//! Storage for radio burst data
 	uint8_t data[BURST_LENGTH_BYTES];
 
+	//! Frequency register image f_0 + carrierOffset, most significant byte first, next to data to avoid padding
+	uint8_t frequencyReg[FREQUENCY_REG_BYTES];
+
 	//! Offset in transmitter register values relative to the system frequency f_0
 	uint16_t carrierOffset;
 
@@ -372,7 +474,6 @@ private:
 			return 11 - (bitIdx >> 1);		// 11  offset
 	}
 
-
 };
 
 };	// namespace TsUnb
@@ -68,6 +68,9 @@ Am Wolfsmantel 33
 91058 Erlangen, Germany
 ks-contracts@iis.fraunhofer.de
 
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
 ----------------------------------------------------------------------------- */
 
 /**
@@ -105,7 +108,9 @@ namespace TsUnb {
  * uint16_t numRadioBursts(MPDU_length) method to return the number of radio bursts as function of the MPDU length.
  * In addition, it has to offer a uint32_t encode(RadioBurst_T* const RadioBursts, const uint8_t* const MPDU, const uint16_t MPDU_Length,
  * const uint8_t TSMAPattern) method for generating the data bursts. The return value is the frequency register setting of the
- * transmitter, or 0 in case of an error.
+ * transmitter, or 0 in case of an error. SimpleNode stores the resulting frequency register value of each
+ * burst with RadioBurst::setFrequencyReg() before the bursts are passed to the int16_t transmit(const RadioBurst_T* const Bursts,
+ * const uint16_t numTxBursts) method of TX.
  *
  *
  */
@@ -164,12 +169,76 @@ public:
 
 		uint16_t MPDU_length = Mac.MPDU_Length(payloadLength, MPF_present);
 
-		if (MPDU_length == 0)
+		if (MPDU_length == 0 || MPDU_length > TSUNBPHY_MAX_PSDU_LENGTH)
 			return -1;
 
 		uint8_t MPDU[MPDU_length];
 		Mac.encode(MPDU, payload, payloadLength, MPF_present, MPF_value);
 
+		return transmitMpdu(MPDU, MPDU_length, priority);
+	}
+
+	/**
+	 * @brief Send method for a payload which is already in the MPDU buffer
+	 *
+	 * Avoids copies of the payload: the MAC writes its header in front of the payload,
+	 * encrypts it in place and appends the tag. Requires a MAC with the HEADROOM and
+	 * TAG_LENGTH constants and the headerLength() and encodeInPlace() methods, e.g.
+	 * FixedUplinkMac.
+	 *
+	 * @param	frame			Buffer of at least MAC::HEADROOM + payloadLength + MAC::TAG_LENGTH bytes,
+	 *							the payload starts at frame[MAC::HEADROOM]
+	 * @param	payloadLength	Length of the payload data in bytes
+	 * @param	MPF_value		MPF field, present if not 0
+	 * @param	priority		Uses low prioty uplink pattern if set 6
+	 *
+	 * @return	Non-negative number in case of success, negative number in case of error
+	 */
+	int16_t sendInPlace(uint8_t* const frame, const uint16_t payloadLength,
+			const uint8_t MPF_value = 0, const bool priority = false) {
+		const bool MPF_present = MPF_value != 0;
+
+		// Checked before the payload is encrypted and the packet counter is incremented
+		const uint16_t MPDU_length = Mac.MPDU_Length(payloadLength, MPF_present);
+		if (MPDU_length == 0 || MPDU_length > TSUNBPHY_MAX_PSDU_LENGTH)
+			return -1;
+
+		uint8_t* const MPDU = &frame[MAC::HEADROOM - Mac.headerLength(MPF_present)];
+		Mac.encodeInPlace(MPDU, payloadLength, MPF_present, MPF_value);
+
+		return transmitMpdu(MPDU, MPDU_length, priority);
+	}
+
+	/**
+	 * @brief Precompute the payload independent encryption of the next packet
+	 *
+	 * Should be called in idle time, e.g. after init() and after each send(), to reduce
+	 * the time between a trigger and the first radio burst. Requires a MAC with a
+	 * prepareNextFrame() method, e.g. FixedUplinkMac.
+	 */
+	void prepareNextFrame() {
+		Mac.prepareNextFrame();
+	}
+
+	//! Instance of TX that is active during the complete lifetime of this class
+	TX Tx;
+
+	//! Instance of the MAC that is active during the complete lifetime of this class
+	MAC Mac;
+
+
+private:
+
+	/**
+	 * @brief PHY encoding and transmission of an MPDU
+	 *
+	 * @param	MPDU			Pointer to the MPDU
+	 * @param	MPDU_length		Length of the MPDU in bytes
+	 * @param	priority		Uses low prioty uplink pattern if set 6
+	 *
+	 * @return	Non-negative number in case of success, negative number in case of error
+	 */
+	int16_t transmitMpdu(const uint8_t* const MPDU, const uint16_t MPDU_length, const bool priority) {
 		//! PHY Instance.
 		PHY Phy;
 
@@ -190,16 +259,9 @@ public:
 				freqReg = Phy.encode(Bursts, MPDU, MPDU_length, 6);
 			else
 				freqReg = Phy.encode(Bursts, MPDU, MPDU_length, Mac.getTsmaPattern());
-
-			if (freqReg > 0)
-				return Tx.transmit(Bursts, numRadioBursts, freqReg);
-			else
-				return -1;
 		}
 		else {
 			// This is special handling in caes of a sync burst
-			numRadioBursts += 1;
-
 			// The first data Burst is Burst[1] as Burst[0] is the Sync Burst
 			if (priority) {
 				freqReg = Phy.encode(&Bursts[1], MPDU, MPDU_length, 6);
@@ -212,18 +274,18 @@ public:
 			}
 
 		}
-		if (freqReg > 0)
-			return Tx.transmit(Bursts, numRadioBursts, freqReg);
-		else
+		if (freqReg == 0)
 			return -1;
 
-	}
+		// Final frequency register values of all bursts incl. the sync burst,
+		// computed here so that the transmitter does not have to do it between the bursts
+		for (uint16_t burstIdx = 0; burstIdx < numRadioBursts; ++burstIdx) {
+			Bursts[burstIdx].setFrequencyReg(freqReg);
+		}
 
-	//! Instance of TX that is active during the complete lifetime of this class
-	TX Tx;
+		return Tx.transmit(Bursts, numRadioBursts);
 
-	//! Instance of the MAC that is active during the complete lifetime of this class
-	MAC Mac;
+	}
 
 
 };
@@ -0,0 +1,273 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	Scatter of the coded bits onto the radio bursts using a precomputed table
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	BurstScatter.h
+ *
+ * Each table entry holds the radio burst in the upper bits and the position of the
+ * bit in the subpacket register of that burst in the lower bits. The subpacket
+ * registers are an array of 32 bit words kept by the encoder, one per radio burst
+ * (see RadioBurst::commitSubPacket()). The entries are created with makeEntry() of
+ * the scatter class that reads them.
+ * SoftwareBurstScatter splits the entry with shifts and masks. On the RP2040 the
+ * SIO interpolator 0 can do the split and the address calculation of the register in
+ * hardware; define TSUNB_USE_INTERP (CMake option of the same name) to select the
+ * InterpBurstScatter. The portable version is used otherwise and on all other
+ * platforms.
+ *
+ */
+
+
+#ifndef TSUNB_BURST_SCATTER_H_
+#define TSUNB_BURST_SCATTER_H_
+
+#include <stdint.h>
+
+#if defined(TSUNB_USE_INTERP)
+#include "hardware/interp.h"
+#endif
+
+namespace TsUnbLib {
+
+/**
+ * @brief Select one of two types at compile time, the lib does not depend on <type_traits>
+ *
+ * @param COND	Condition
+ * @param A		Type if COND is true
+ * @param B		Type if COND is false
+ */
+template <bool COND, class A, class B>
+struct SelectType {
+	typedef A type;	//!< Selected type
+};
+
+//! Specialization for a false condition
+template <class A, class B>
+struct SelectType<false, A, B> {
+	typedef B type;	//!< Selected type
+};
+
+/**
+ * @brief Portable scatter of the coded bits onto the radio bursts
+ *
+ * @param Entry_T		Type of the scatter table entries
+ * @param BURST_SHIFT	Position of the burst index in a table entry
+ */
+template <typename Entry_T, uint8_t BURST_SHIFT>
+class SoftwareBurstScatter {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param	SubPacketBits	Subpacket registers of the radio bursts the bits are written to
+	 */
+	explicit SoftwareBurstScatter(uint32_t* const SubPacketBits) : SubPacketBits(SubPacketBits) {}
+
+	//! Maximum number of radio bursts that can be addressed by a table entry
+	static constexpr uint32_t MAX_BURSTS = (uint32_t) 1 << (8 * sizeof(Entry_T) - BURST_SHIFT);
+
+	/**
+	 * @brief Create a scatter table entry
+	 *
+	 * @param	burstIdx	Index of the radio burst
+	 * @param	regBit		Position returned by RadioBurst::getSubPkgRegBit()
+	 *
+	 * @return	Table entry with the burst index in the upper bits
+	 */
+	static constexpr Entry_T makeEntry(const uint16_t burstIdx, const uint8_t regBit) {
+		return (Entry_T) (burstIdx << BURST_SHIFT) | regBit;
+	}
+
+	/**
+	 * @brief Write 24 coded bits onto their positions on the radio bursts
+	 *
+	 * @param	entries		Scatter table entries of the 24 bits
+	 * @param	codedBits	Coded bits, first bit in bit 23
+	 */
+	void write24(const Entry_T* const entries, const uint32_t codedBits) const {
+		for (uint8_t i = 0; i < 24; ++i) {
+			const Entry_T e = entries[i];
+			SubPacketBits[e >> BURST_SHIFT] |= ((codedBits >> (23 - i)) & 1) << (e & ((1 << BURST_SHIFT) - 1));
+		}
+	}
+
+private:
+	uint32_t* const SubPacketBits;	//!< Subpacket registers of the radio bursts
+};
+
+
+#if defined(TSUNB_USE_INTERP)
+
+/**
+ * @brief Scatter of the coded bits onto the radio bursts using the SIO interpolator 0
+ *
+ * Lane 0 converts a table entry into the address of the subpacket register of the
+ * radio burst (base 0 is the address of the first register), lane 1 masks the position
+ * in the register out of the same entry (cross input). The interpolator state is saved
+ * by the constructor and restored by the destructor, so the object must not live
+ * longer than one encoding.
+ *
+ * @param Entry_T		Type of the scatter table entries
+ * @param BURST_SHIFT	Position of the burst index in a table entry
+ */
+template <typename Entry_T, uint8_t BURST_SHIFT>
+class InterpBurstScatter {
+public:
+	//! log2 of the size of a subpacket register, the lane shifts the burst index into place
+	static constexpr uint8_t REG_SIZE_LOG2 = 2;
+
+	static_assert(REG_SIZE_LOG2 <= BURST_SHIFT, "The interpolator can only shift right");
+
+	//! Maximum number of radio bursts that can be addressed by a table entry
+	static constexpr uint32_t MAX_BURSTS = (uint32_t) 1 << (8 * sizeof(Entry_T) - BURST_SHIFT);
+
+	/**
+	 * @brief Create a scatter table entry
+	 *
+	 * @param	burstIdx	Index of the radio burst
+	 * @param	regBit		Position returned by RadioBurst::getSubPkgRegBit()
+	 *
+	 * @return	Table entry with the burst index in the upper bits
+	 */
+	static constexpr Entry_T makeEntry(const uint16_t burstIdx, const uint8_t regBit) {
+		return (Entry_T) (burstIdx << BURST_SHIFT) | regBit;
+	}
+
+	/**
+	 * @brief Constructor, configures the interpolator 0
+	 *
+	 * @param	SubPacketBits	Subpacket registers of the radio bursts the bits are written to
+	 */
+	explicit InterpBurstScatter(uint32_t* const SubPacketBits) {
+		interp_save(interp0, &savedState);
+
+		interp_config cfg = interp_default_config();
+		interp_config_set_shift(&cfg, BURST_SHIFT - REG_SIZE_LOG2);
+		interp_config_set_mask(&cfg, REG_SIZE_LOG2, REG_SIZE_LOG2 + 8 * sizeof(Entry_T) - BURST_SHIFT - 1);
+		interp_set_config(interp0, 0, &cfg);
+
+		cfg = interp_default_config();
+		interp_config_set_cross_input(&cfg, true);
+		interp_config_set_mask(&cfg, 0, BURST_SHIFT - 1);
+		interp_set_config(interp0, 1, &cfg);
+
+		interp0->base[0] = (uint32_t) (uintptr_t) SubPacketBits;
+		interp0->base[1] = 0;
+	}
+
+	//! Destructor, restores the interpolator 0
+	~InterpBurstScatter() {
+		interp_restore(interp0, &savedState);
+	}
+
+	InterpBurstScatter(const InterpBurstScatter&) = delete;
+	InterpBurstScatter& operator=(const InterpBurstScatter&) = delete;
+
+	/**
+	 * @brief Write 24 coded bits onto their positions on the radio bursts
+	 *
+	 * @param	entries		Scatter table entries of the 24 bits
+	 * @param	codedBits	Coded bits, first bit in bit 23
+	 */
+	void write24(const Entry_T* const entries, const uint32_t codedBits) const {
+		for (uint8_t i = 0; i < 24; ++i) {
+			interp0->accum[0] = entries[i];
+			uint32_t* const subPacketBits = (uint32_t*) (uintptr_t) interp0->peek[0];
+			*subPacketBits |= ((codedBits >> (23 - i)) & 1) << interp0->peek[1];
+		}
+	}
+
+private:
+	interp_hw_save_t savedState;	//!< Interpolator state of the caller
+};
+
+//! Scatter implementation selected by TSUNB_USE_INTERP
+template <typename Entry_T, uint8_t BURST_SHIFT>
+using BurstScatter = InterpBurstScatter<Entry_T, BURST_SHIFT>;
+
+#else
+
+//! Scatter implementation selected by TSUNB_USE_INTERP
+template <typename Entry_T, uint8_t BURST_SHIFT>
+using BurstScatter = SoftwareBurstScatter<Entry_T, BURST_SHIFT>;
+
+#endif
+
+};	// namespace TsUnbLib
+
+#endif	//	TSUNB_BURST_SCATTER_H_
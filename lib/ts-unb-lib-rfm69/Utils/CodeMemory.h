@@ -0,0 +1,112 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	Placement of the time-critical code of the TS-UNB-Lib
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	CodeMemory.h
+ *
+ * The burst sequencing of the transmitter (everything executed between starting and
+ * stopping the symbol timer) should not wait for XIP cache misses on the RP2040.
+ * Defining TSUNB_TX_IN_RAM (CMake option of the same name, off by default) places the
+ * functions marked with TSUNB_TIME_CRITICAL in SRAM. They are neither inlined nor cloned,
+ * so the placement is kept and can be checked in the linked binary
+ * (tools/check_ram_hot_path.py). Small helpers of the hot path are marked with
+ * TSUNB_TIME_CRITICAL_INLINE instead, they are inlined into their callers also without
+ * optimization (-O0/-Og), so no copy in flash is called. GCC honours the section of
+ * template functions from version 14 on. On other platforms the attributes are empty.
+ * The effect on the burst start jitter has not been measured on hardware yet, see
+ * TSUNB_TIMING_STATS.
+ *
+ */
+
+
+#ifndef TSUNB_CODE_MEMORY_H_
+#define TSUNB_CODE_MEMORY_H_
+
+#if defined(TSUNB_TX_IN_RAM) && !defined(__AVR_ARCH__)
+//! Attribute for functions of the transmit hot path
+#define TSUNB_TIME_CRITICAL		__attribute__((noinline, noclone, section(".time_critical.tsunb")))
+//! Attribute for small helpers of the transmit hot path, always inlined
+#define TSUNB_TIME_CRITICAL_INLINE	inline __attribute__((always_inline))
+#else
+//! Attribute for functions of the transmit hot path
+#define TSUNB_TIME_CRITICAL
+//! Attribute for small helpers of the transmit hot path, always inlined
+#define TSUNB_TIME_CRITICAL_INLINE	inline
+#endif
+
+#endif // TSUNB_CODE_MEMORY_H_
@@ -0,0 +1,214 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	Table driven rate 1/3 convolutional encoder processing 8 bits per step
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	ConvEncoder.h
+ *
+ */
+
+
+#ifndef TSUNB_CONV_ENCODER_H_
+#define TSUNB_CONV_ENCODER_H_
+
+#include <stdint.h>
+
+#include "TableMemory.h"
+
+namespace TsUnbLib {
+
+/**
+ * @brief Lookup tables of a rate 1/3 convolutional encoder with memory 6
+ *
+ * The code is linear. The 24 output bits of one input byte are therefore the
+ * XOR of the output caused by the 6 bit register state (with zero input) and the
+ * output caused by the 8 input bits (starting from the zero state).
+ * The 24 output bits are right aligned, the first output bit is bit 23.
+ */
+struct ConvEncoderTables {
+	uint32_t input[256];	//!< Output bits for the input byte starting from the zero state
+	uint32_t state[64];		//!< Output bits for the register state with zero input
+};
+
+/**
+ * @brief Generate the lookup tables of a rate 1/3 convolutional encoder at compile time
+ *
+ * The tables are intended to initialize a constant that is defined with TSUNB_TABLE_ATTR,
+ * see TableMemory.h.
+ *
+ * @tparam	G1	First generator polynomial (7 bit, LSB is the newest input bit)
+ * @tparam	G2	Second generator polynomial
+ * @tparam	G3	Third generator polynomial
+ *
+ * @return	Lookup tables
+ */
+template <uint8_t G1, uint8_t G2, uint8_t G3>
+constexpr ConvEncoderTables makeConvEncoderTables() {
+	ConvEncoderTables t = {};
+
+	// Bit serial encoding of 8 bits from the register state reg and the input byte
+	auto encode = [](uint8_t reg, const uint8_t byte) {
+		uint32_t out = 0;
+		for (uint8_t bit = 0; bit < 8; ++bit) {
+			reg = (uint8_t)(reg << 1) | ((byte >> (7 - bit)) & 1);
+
+			const uint8_t polys[3] = {G1, G2, G3};
+			for (uint8_t i = 0; i < 3; ++i) {
+				uint8_t parity = reg & polys[i];
+				parity ^= parity >> 4;
+				parity ^= parity >> 2;
+				parity ^= parity >> 1;
+				out = (out << 1) | (parity & 1);
+			}
+		}
+		return out;
+	};
+
+	for (uint16_t i = 0; i < 256; ++i)
+		t.input[i] = encode(0, (uint8_t)i);
+	for (uint8_t i = 0; i < 64; ++i)
+		t.state[i] = encode(i, 0);
+
+	return t;
+}
+
+
+/**
+ * @brief Rate 1/3 convolutional encoder with memory 6 processing 8 input bits per step
+ *
+ * Each call of encodeByte() shifts 8 input bits (MSB first) into the encoder and
+ * returns the 24 coded bits, where the first coded bit is bit 23. For each input bit
+ * the outputs of G1, G2 and G3 are returned in this order.
+ *
+ * The register state equals the 6 last input bits. For tail-biting, the register can
+ * be pre-loaded with the last byte of the input data.
+ *
+ * @tparam	TABLES	Lookup tables generated by makeConvEncoderTables()
+ *
+ */
+template <const ConvEncoderTables& TABLES>
+class ConvEncoder {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param	lastByte	Byte the register is pre-loaded with, only the 6 LSBs are used
+	 */
+	ConvEncoder(const uint8_t lastByte = 0) {
+		preload(lastByte);
+	}
+
+	/**
+	 * @brief Pre-load the register as if lastByte had just been encoded
+	 *
+	 * @param	lastByte	Byte the register is pre-loaded with, only the 6 LSBs are used
+	 */
+	void preload(const uint8_t lastByte) {
+		state = lastByte & 0x3F;
+	}
+
+	/**
+	 * @brief Encode 8 input bits
+	 *
+	 * @param	byte	Input bits, MSB first
+	 *
+	 * @return	24 coded bits, the first coded bit is bit 23
+	 */
+	uint32_t encodeByte(const uint8_t byte) {
+		const uint32_t out = TSUNB_TABLE_READ_DWORD(TABLES.state[state])
+				^ TSUNB_TABLE_READ_DWORD(TABLES.input[byte]);
+		state = byte & 0x3F;
+		return out;
+	}
+
+	/**
+	 * @brief Get the current register state
+	 *
+	 * @return	6 last input bits
+	 */
+	uint8_t getState() const {
+		return state;
+	}
+
+private:
+	//! Register state, i.e. the 6 last input bits
+	uint8_t state;
+};
+
+};	// namespace TsUnbLib
+
+#endif // TSUNB_CONV_ENCODER_H_
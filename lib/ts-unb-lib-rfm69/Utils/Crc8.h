@@ -0,0 +1,194 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	Table driven CRC8 engine with MSB first bit order
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	Crc8.h
+ *
+ */
+
+
+#ifndef TSUNB_CRC8_H_
+#define TSUNB_CRC8_H_
+
+#include <stdint.h>
+
+#include "TableMemory.h"
+
+namespace TsUnbLib {
+
+/**
+ * @brief Lookup table of a CRC8, wrapped into a struct to allow compile time generation
+ */
+struct Crc8Table {
+	uint8_t entry[256];		//!< CRC register after shifting in 8 zero bits starting from the index
+};
+
+/**
+ * @brief Generate the lookup table of a CRC8 at compile time
+ *
+ * The table is intended to initialize a constant that is defined with TSUNB_TABLE_ATTR,
+ * see TableMemory.h, e.g.
+ * TSUNB_TABLE_ATTR inline const Crc8Table MY_CRC8_TABLE = makeCrc8Table<0x9B>();
+ *
+ * @tparam	POLY	CRC polynomial without the leading x^8 term
+ *
+ * @return	Lookup table
+ */
+template <uint8_t POLY>
+constexpr Crc8Table makeCrc8Table() {
+	Crc8Table t = {};
+	for (uint16_t i = 0; i < 256; ++i) {
+		uint8_t reg = (uint8_t)i;
+		for (uint8_t bit = 0; bit < 8; ++bit)
+			reg = (reg & 0x80) ? (uint8_t)((reg << 1) ^ POLY) : (uint8_t)(reg << 1);
+		t.entry[i] = reg;
+	}
+	return t;
+}
+
+/**
+ * @brief Byte-wise CRC8 calculation using a 256 entry lookup table
+ *
+ * This class calculates the same CRC8 as a bit serial Galois LFSR, where the
+ * input bits are read MSB first. Full bytes are processed with a single
+ * table lookup. A trailing incomplete byte (e.g. the 2 bit MMODE field of the
+ * TS-UNB PHY) is processed with one additional lookup, as shifting k < 8 bits
+ * into the register is identical to a table lookup of the k most significant
+ * bits followed by a shift of the remaining register bits.
+ *
+ * @tparam	TABLE	Lookup table generated by makeCrc8Table()
+ *
+ */
+template <const Crc8Table& TABLE>
+class Crc8 {
+public:
+	/**
+	 * @brief Calculation of the CRC8
+	 *
+	 * @param	crc				Initial state of the CRC register
+	 * @param	inputBytes		Pointer to byte input memory
+	 * @param	numInputBits	Number of input bits for the calculation of the CRC
+	 *
+	 * @return	Calculated CRC8
+	 *
+	 */
+	static uint8_t calc(uint8_t crc, const uint8_t* const inputBytes, const uint16_t numInputBits) {
+		const uint16_t numBytes = numInputBits >> 3;
+
+		for (uint16_t i = 0; i < numBytes; ++i)
+			crc = update(crc, inputBytes[i]);
+
+		const uint8_t tailBits = numInputBits & 0x07;
+		if (tailBits)
+			crc = updateBits(crc, inputBytes[numBytes], tailBits);
+
+		return crc;
+	}
+
+	/**
+	 * @brief Shift a complete byte into the CRC register
+	 *
+	 * @param	crc		Current state of the CRC register
+	 * @param	byte	Input byte, MSB first
+	 *
+	 * @return	New state of the CRC register
+	 *
+	 */
+	static uint8_t update(const uint8_t crc, const uint8_t byte) {
+		return TSUNB_TABLE_READ_BYTE(TABLE.entry[crc ^ byte]);
+	}
+
+	/**
+	 * @brief Shift the most significant bits of a byte into the CRC register
+	 *
+	 * @param	crc		Current state of the CRC register
+	 * @param	byte	Input byte, only the numBits MSBs are used
+	 * @param	numBits	Number of bits, 1 to 8
+	 *
+	 * @return	New state of the CRC register
+	 *
+	 */
+	static uint8_t updateBits(const uint8_t crc, const uint8_t byte, const uint8_t numBits) {
+		const uint8_t idx = (uint8_t)(crc ^ byte) >> (8 - numBits);
+		return (uint8_t)(crc << numBits) ^ TSUNB_TABLE_READ_BYTE(TABLE.entry[idx]);
+	}
+};
+
+};	// namespace TsUnbLib
+
+#endif // TSUNB_CRC8_H_
@@ -0,0 +1,280 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	Drift-free TS-UNB symbol clock for interrupt driven timers
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	SymbolClock.h
+ *
+ * The TS-UNB symbol duration 10^6 / (49.591064453125 Hz * SYMBOL_RATE_MULT) is not a whole
+ * number of microseconds, but exactly 262144 / (13 * SYMBOL_RATE_MULT) us, e.g. 16384/39 us
+ * for SYMBOL_RATE_MULT = 48. The clock keeps the phase of the symbol grid relative to the
+ * last scheduled timer interrupt as whole microseconds plus a fraction in units of
+ * 1 / (13 * SYMBOL_RATE_MULT) us. The timer is rescheduled in whole microseconds, the
+ * rounding error stays in the phase and never accumulates. Per symbol only integer
+ * additions and compares are executed, i.e. no floating point and no division in the ISR.
+ *
+ */
+
+
+#ifndef TSUNB_SYMBOL_CLOCK_H_
+#define TSUNB_SYMBOL_CLOCK_H_
+
+#include <stdint.h>
+
+#include "CodeMemory.h"
+
+namespace TsUnbLib {
+namespace TsUnb {
+
+
+/**
+ * @brief Symbol clock of the TS-UNB transmitter timer
+ *
+ * The clock implements the scheduling of the periodic timer interrupt: start() returns the
+ * delay of the first interrupt, tick() is called in each interrupt and returns whether it
+ * marks the end of a symbol period (i.e. waitTimer() may return) and the delay until the
+ * next interrupt. addDelay() extends the next symbol period to count symbols.
+ */
+class SymbolClock {
+public:
+	//! Numerator of the symbol duration in microseconds (10^6 / 49.591064453125 = 262144 / 13)
+	static const uint32_t SYMBOL_DURATION_NUM = 262144;
+
+	/**
+	 * @brief Denominator of the symbol duration in microseconds
+	 *
+	 * @param symbolRateMult 	Symbol rate in multiples of 49.591064453125 Hz
+	 */
+	static constexpr uint16_t symbolDurationDen(const uint16_t symbolRateMult) {
+		return 13 * symbolRateMult;
+	}
+
+	/**
+	 * @brief Sets the symbol rate and clears the phase
+	 *
+	 * @param symbolRateMult 	Symbol rate in multiples of 49.591064453125 Hz, at most 5041
+	 */
+	void init(const uint16_t symbolRateMult) {
+		den = symbolDurationDen(symbolRateMult);
+		symbolUs = SYMBOL_DURATION_NUM / den;
+		symbolFrac = SYMBOL_DURATION_NUM % den;
+		phaseUs = 0;
+		phaseFrac = 0;
+		delayPending = false;
+		nextUs = 0;
+	}
+
+	/**
+	 * @brief Starts the clock
+	 *
+	 * If no delay was added before, the first interrupt occurs after one symbol.
+	 *
+	 * @return 	Delay of the first interrupt in microseconds
+	 */
+	uint32_t start() {
+		if (phaseUs == 0 && phaseFrac == 0)
+			addSymbol();
+		delayPending = false;
+		nextUs = takeRounded();
+		return nextUs;
+	}
+
+	/**
+	 * @brief Extends the current symbol period to count symbols
+	 *
+	 * Has to be called after the end of a symbol period, before the next interrupt.
+	 *
+	 * @param count 	Length of the period in symbols, one or less keeps a single symbol
+	 */
+	TSUNB_TIME_CRITICAL void addDelay(const int32_t count) {
+		if (count <= 1)
+			return;
+		addSymbols((uint16_t) (count - 1));
+		delayPending = true;
+	}
+
+	/**
+	 * @brief Extends the symbol period scheduled by the last tick() to count symbols
+	 *
+	 * Can be called in the timer interrupt after tick() returned true. In contrast to addDelay()
+	 * the next interrupt is the end of the extended period, i.e. there is no interrupt in between.
+	 * getNextUs() returns the delay of the complete period afterwards.
+	 *
+	 * @param count 	Length of the period in symbols, one or less keeps a single symbol
+	 */
+	TSUNB_TIME_CRITICAL void extendPeriod(const int32_t count) {
+		if (count <= 1)
+			return;
+		addSymbols((uint16_t) (count - 1));
+		nextUs += takeRounded();
+	}
+
+	/**
+	 * @brief Advances the clock in the timer interrupt
+	 *
+	 * @return 	True if the interrupt marks the end of a symbol period
+	 */
+	TSUNB_TIME_CRITICAL bool tick() {
+		const bool endOfPeriod = !delayPending;
+		if (endOfPeriod)
+			addSymbol();
+		else
+			delayPending = false;
+		nextUs = takeRounded();
+		return endOfPeriod;
+	}
+
+	/**
+	 * @brief Delay from the last interrupt (or start) to the next one in microseconds
+	 */
+	TSUNB_TIME_CRITICAL uint32_t getNextUs() const {
+		return nextUs;
+	}
+
+	/**
+	 * @brief Symbol grid time not yet scheduled, in units of 1 / den microseconds
+	 *
+	 * This is the deviation of the next scheduled interrupt from the exact symbol grid
+	 * with inverted sign, always within +-den/2.
+	 */
+	int32_t getPhase() const {
+		return phaseUs * (int32_t) den + (int32_t) phaseFrac;
+	}
+
+	/**
+	 * @brief Denominator of the phase, 13 * symbolRateMult
+	 */
+	uint16_t getDen() const {
+		return den;
+	}
+
+private:
+	//! Adds one symbol duration to the phase
+	TSUNB_TIME_CRITICAL void addSymbol() {
+		uint32_t frac = phaseFrac + symbolFrac;
+		int32_t us = phaseUs + (int32_t) symbolUs;
+		if (frac >= den) {
+			frac -= den;
+			++us;
+		}
+		phaseFrac = frac;
+		phaseUs = us;
+	}
+
+	//! Adds multiple symbol durations to the phase, the fraction is reduced by a shift-subtract division
+	TSUNB_TIME_CRITICAL void addSymbols(const uint16_t symbols) {
+		uint32_t frac = phaseFrac + (uint32_t) symbols * symbolFrac;
+		int32_t us = phaseUs + (int32_t) ((uint32_t) symbols * symbolUs);
+		for (int8_t shift = 15; shift >= 0; --shift) {
+			const uint32_t d = (uint32_t) den << shift;
+			if (frac >= d) {
+				frac -= d;
+				us += (int32_t) 1 << shift;
+			}
+		}
+		phaseFrac = frac;
+		phaseUs = us;
+	}
+
+	//! Rounds the phase to whole microseconds, removes and returns them
+	TSUNB_TIME_CRITICAL uint32_t takeRounded() {
+		const int32_t us = phaseUs + (2 * phaseFrac >= den ? 1 : 0);
+		phaseUs = phaseUs - us;
+		return (uint32_t) us;
+	}
+
+	//! Denominator of the fractions
+	uint16_t den;
+	//! Whole microseconds of a symbol
+	uint32_t symbolUs;
+	//! Fraction of a symbol in units of 1 / den microseconds
+	uint32_t symbolFrac;
+	//! Whole microseconds of the phase, -1 or 0 after rounding
+	volatile int32_t phaseUs;
+	//! Fraction of the phase in units of 1 / den microseconds
+	volatile uint32_t phaseFrac;
+	//! The next interrupt ends a delay and not a symbol period
+	volatile bool delayPending;
+	//! Delay until the next interrupt in microseconds
+	volatile uint32_t nextUs;
+};
+
+
+};	// namespace TsUnb
+};	// namespace TsUnbLib
+
+#endif // TSUNB_SYMBOL_CLOCK_H_
@@ -0,0 +1,281 @@
+/* -----------------------------------------------------------------------------
+
+Software License for the Fraunhofer TS-UNB-Lib
+
+(c) Copyright  2019 - 2023 Fraunhofer-Gesellschaft zur Förderung der angewandten
+Forschung e.V. All rights reserved.
+
+
+1. INTRODUCTION
+
+The Fraunhofer Telegram Splitting - Ultra Narrowband Library ("TS-UNB-Lib") is software
+that implements only the uplink of the ETSI TS 103 357 TS-UNB standard ("MIOTY") for wireless 
+data transmission in the field of IoT. Patent licenses for any patent claim regarding the 
+ETSI TS 103 357 TS-UNB standard implementation (including those of Fraunhofer) may be 
+obtained through Sisvel International S.A. 
+(https://www.sisvel.com/licensing-programs/wireless-communications/mioty/license-terms)
+or through the respective patent owners individually. The purpose of this TS-UNB-Lib is 
+academic and non-commercial use. Therefore, Fraunhofer does not offer any support for the 
+TS-UNB-Lib. Furthermore, the TS-UNB-Lib is NOT identical and on the same quality level as 
+the commercially-licensed MIOTY software also available from Fraunhofer. Users are encouraged
+to check the Fraunhofer website for additional applications information and documentation.
+
+
+2. COPYRIGHT LICENSE
+
+Redistribution and use in source and binary forms, with or without modification, are 
+permitted without payment of copyright license fees provided that you satisfy the following 
+conditions: You must retain the complete text of this software license in redistributions
+of the TS-UNB-Lib software or your modifications thereto in source code form. You must retain 
+the complete text of this software license in the documentation and/or other materials provided
+with redistributions of the TS-UNB-Lib software or your modifications thereto in binary form.
+You must make available free of charge copies of the complete source code of the TS-UNB-Lib 
+software and your modifications thereto to recipients of copies in binary form. The name of 
+Fraunhofer may not be used to endorse or promote products derived from this software without
+prior written permission. You may not charge copyright license fees for anyone to use, copy or
+distribute the TS-UNB-Lib software or your modifications thereto. Your modified versions of the
+TS-UNB-Lib software must carry prominent notices stating that you changed the software and the
+date of any change. For modified versions of the TS-UNB-Lib software, the term 
+"Fraunhofer TS-UNB-Lib" must be replaced by the term
+"Third-Party Modified Version of the Fraunhofer TS-UNB-Lib."
+
+
+3. NO PATENT LICENSE
+
+NO EXPRESS OR IMPLIED LICENSES TO ANY PATENT CLAIMS, including without limitation the patents 
+of Fraunhofer, ARE GRANTED BY THIS SOFTWARE LICENSE. Fraunhofer provides no warranty of patent 
+non-infringement with respect to this software. You may use this TS-UNB-Lib software or modifications
+thereto only for purposes that are authorized by appropriate patent licenses.
+
+
+4. DISCLAIMER
+
+This TS-UNB-Lib software is provided by Fraunhofer on behalf of the copyright holders and contributors
+"AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties
+of merchantability and fitness for a particular purpose. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages,
+including but not limited to procurement of substitute goods or services; loss of use, data, or profits,
+or business interruption, however caused and on any theory of liability, whether in contract, strict
+liability, or tort (including negligence), arising in any way out of the use of this software, even if
+advised of the possibility of such damage.
+
+
+5. CONTACT INFORMATION
+
+Fraunhofer Institute for Integrated Circuits IIS
+Attention: Division Communication Systems
+Am Wolfsmantel 33
+91058 Erlangen, Germany
+ks-contracts@iis.fraunhofer.de
+
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
+----------------------------------------------------------------------------- */
+
+/**
+ * @brief	TS-UNB abstractions for host builds (e.g. Linux)
+ *
+ * @authors	mioty Alliance e.V.
+ * @file	HostTsUnb.h
+ *
+ * This file offers a stub platform implementation, which allows building the complete
+ * header-only TS-UNB stack (SimpleNode, FixedUplinkMac, Phy, RadioBurst and the transceiver)
+ * without the Pico SDK, e.g. for tests and benchmarks of the encoder on the host.
+ *
+ */
+
+
+
+#ifndef HOST_TSUNB_H_
+#define HOST_TSUNB_H_
+
+#include <inttypes.h>
+
+#include "../TsUnb/RadioBurst.h"
+#include "../TsUnb/FixedMac.h"
+#include "../TsUnb/Phy.h"
+#include "../TsUnb/SimpleNode.h"
+#include "../Trx/Rfm69hw.h"
+
+namespace TsUnbLib {
+namespace Host {
+
+
+/**
+ * @brief Stub platform implementation of TS-UNB for host builds
+ *
+ * This class offers the same methods as RPPicoTsUnb, but does not access any hardware.
+ * The timer does not wait, it only counts the elapsed symbols. The SPI emulates the
+ * register file of the transceiver, i.e. written registers can be read back. The register
+ * 0x0c is preset, as the RFM69HW driver uses it to detect the chip.
+ *
+ * @param SYMBOL_RATE_MULT    TS-UNB, symbol rate in multiples of 49.591064453125, see RPPicoTsUnb
+ */
+template <uint16_t SYMBOL_RATE_MULT = 48>
+class HostTsUnb {
+public:
+	HostTsUnb() {
+		for (uint16_t i = 0; i < NUM_REGISTERS; ++i)
+			registers[i] = 0;
+		registers[0x0c] = 0x02;
+		elapsedSymbols = 0;
+		spiTransfers = 0;
+		spiBytes = 0;
+	}
+
+	~HostTsUnb() {
+	}
+
+	/**
+	 * @brief Bit duration in microseconds
+	 */
+	static constexpr float TS_UNB_BIT_DURATION_US = (double) 1000000 / (49.591064453125 * (double)SYMBOL_RATE_MULT);
+
+	/**
+	 * @brief Init the timer
+	 */
+	void initTimer() {
+		elapsedSymbols = 0;
+	}
+
+	/**
+	 * @brief Start the timer
+	 */
+	void startTimer() {
+	}
+
+	/**
+	 * @brief Stop the timer
+	 */
+	void stopTimer() {
+	}
+
+	/**
+	 * @brief Add the counter compare value for the next interrupt
+	 *
+	 * @param count Delay in TX symbols
+	 */
+	void addTimerDelay(const int32_t count) {
+		elapsedSymbols += count;
+	}
+
+	/**
+	 * @brief Wait until the timer values expires, returns immediately
+	 */
+	void waitTimer() const {
+	}
+
+	/**
+	 * @brief Initialization of the SPI interface
+	 */
+	void spiInit(void) {
+	}
+
+	/**
+	 * @brief Deinitialization of the SPI interface
+	 */
+	void spiDeinit(void) {
+	}
+
+	/**
+	 * @brief Sends multiple bytes using SPI
+	 *
+	 * The first byte is the register address with the write flag in the MSB. The following
+	 * bytes are written to consecutive registers, except for the FIFO register 0x00.
+	 *
+	 * @param dataOut Bytes to be transmitted
+	 * @param numBytes Number of bytes to be transmitted
+	 */
+	void spiSend(const uint8_t* const dataOut, const uint8_t numBytes) {
+		++spiTransfers;
+		spiBytes += numBytes;
+
+		if (numBytes == 0 || (dataOut[0] & 0x80) == 0)
+			return;
+
+		uint8_t address = dataOut[0] & 0x7F;
+		for (uint8_t i = 1; i < numBytes; ++i) {
+			registers[address] = dataOut[i];
+			if (address != 0)
+				address = (address + 1) & 0x7F;
+		}
+	}
+
+	/**
+	 * @brief Sends and receives multiple bytes using SPI
+	 *
+	 * Reads consecutive registers. As on the hardware the first returned byte has no meaning.
+	 *
+	 * @param dataInOut Bytes to be transmitted and buffer containing the read data
+	 * @param numBytes  Number of bytes to be transmitted
+	 */
+	void spiSendReceive(uint8_t* const dataInOut, const uint8_t numBytes) {
+		if (numBytes > 0 && (dataInOut[0] & 0x80)) {
+			spiSend(dataInOut, numBytes);
+			return;
+		}
+
+		++spiTransfers;
+		spiBytes += numBytes;
+
+		uint8_t address = numBytes > 0 ? dataInOut[0] : 0;
+		for (uint8_t i = 1; i < numBytes; ++i) {
+			dataInOut[i] = registers[address];
+			address = (address + 1) & 0x7F;
+		}
+		if (numBytes > 0)
+			dataInOut[0] = 0;
+	}
+
+	/**
+	 * @brief Reset watchdog (just stub, not implemented)
+	 */
+	void resetWatchdog() {};
+
+	//! Number of emulated transceiver registers
+	static const uint16_t NUM_REGISTERS = 128;
+
+	//! Emulated transceiver registers
+	uint8_t registers[NUM_REGISTERS];
+
+	//! Number of symbols added to the timer since initTimer()
+	int32_t elapsedSymbols;
+
+	//! Number of SPI transfers
+	uint32_t spiTransfers;
+
+	//! Number of transmitted SPI bytes
+	uint32_t spiBytes;
+};
+
+
+/////////////////////////////////
+// RFM69hw
+/////////////////////////////////
+
+//! Host build in EU0 configuration
+typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
+	Trx::Rfm69hw<HostTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU0_Host_t;
+
+//! Host build in EU1 configuration
+typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
+	Trx::Rfm69hw<HostTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU1_Host_t;
+
+//! Host build in EU2 configuration
+typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
+	Trx::Rfm69hw<HostTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU2_Host_t;
+
+//! Host build in US0 configuration
+typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
+	Trx::Rfm69hw<HostTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, true> TsUnb_US0_Host_t;
+
+
+};	// namespace Host
+};	// namespace TsUnbLib
+
+#endif 	// HOST_TSUNB_H_
@@ -100,6 +100,9 @@ Modifications by mioty Alliance e.V. (2025)
 #include "../TsUnb/FixedMac.h"
 #include "../TsUnb/Phy.h"
 #include "../TsUnb/SimpleNode.h"
+#include "../Utils/CodeMemory.h"
+#include "../Utils/SymbolClock.h"
+#include "../Trx/TxSequence.h"
 
 // Include board configuration for GPIO pin definitions
 #include "../../../src/config/board_config.hpp"
@@ -114,17 +117,81 @@ Modifications by mioty Alliance e.V. (2025)
  */
 #define SPI_BAUDRATE	Board::Comm::MIOTY_SPI_BAUDRATE
 
+/**
+ * @brief Time before the next timer interrupt in us from which waitTimer() spins instead of sleeping
+ *
+ * Other interrupts (e.g. USB) also end the sleep of waitTimer(). Shortly before the timer
+ * interrupt the core does not go back to sleep, so that the wake-up does not delay the burst.
+ */
+#ifndef TSUNB_WAIT_SPIN_US
+#define TSUNB_WAIT_SPIN_US	8
+#endif
+
 namespace TsUnbLib {
 namespace RPPico {
 
 
 //! Flag to indicate end of timer
-extern volatile absolute_time_t TimeAddedDelay;
 extern volatile bool TsUnbTimerFlag;
-extern volatile bool ExtraDelaySet;
-extern volatile float preciseTsUnbTimer_us;
-extern volatile float TsUnbBitDuration_us;
-extern volatile int64_t TsUnbTimeNextCycle_us;
+//! Symbol clock scheduling the timer interrupts
+extern TsUnb::SymbolClock TsUnbSymbolClock;
+//! Timer value (time_us_32) of the next timer interrupt
+extern volatile uint32_t TsUnbTimerNextAt_us;
+
+#ifdef TSUNB_TIMING_STATS
+//! Timer value (time_us_32) at the last timer interrupt
+extern volatile uint32_t TsUnbTimerFiredAt_us;
+//! Minimum delay between the timer interrupt and the return of waitTimer() since startTimer()
+extern volatile uint32_t TsUnbWakeLatencyMin_us;
+//! Maximum delay between the timer interrupt and the return of waitTimer() since startTimer()
+extern volatile uint32_t TsUnbWakeLatencyMax_us;
+//! Number of timer interrupts since startTimer()
+extern volatile uint32_t TsUnbTimerInterrupts;
+//! Time waitTimer() has slept in __wfe() since startTimer()
+extern volatile uint32_t TsUnbWaitSleep_us;
+//! Time waitTimer() has spun on the timer flag since startTimer()
+extern volatile uint32_t TsUnbWaitSpin_us;
+//! Number of wake-ups from __wfe() in waitTimer() since startTimer(), incl. other interrupts
+extern volatile uint32_t TsUnbWaitWakeUps;
+#endif
+
+#ifdef TSUNB_TX_SEQUENCER
+//! Maximum number of radio bursts of a packet incl. a sync burst
+#define TSUNB_TX_SEQUENCE_MAX_BURSTS	(TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD + 1)
+
+//! Bytes of the command list per radio burst, RadioBurst<2,2>: frequency 5, FIFO 8, modes 3 * 3
+#define TSUNB_TX_SEQUENCE_BURST_BYTES	22
+
+//! Steps per radio burst: wake-up, TX, sleep and with pre-tuning loading the next burst
+#ifdef TSUNB_TX_PRETUNE
+#define TSUNB_TX_SEQUENCE_BURST_STEPS	4
+#else
+#define TSUNB_TX_SEQUENCE_BURST_STEPS	3
+#endif
+
+//! Command list of the transmit sequencer, sized for the longest packet: 10404 bytes of SRAM, 11964 with TSUNB_TX_PRETUNE
+typedef Trx::TxSequence<TSUNB_TX_SEQUENCE_BURST_STEPS * TSUNB_TX_SEQUENCE_MAX_BURSTS,
+		TSUNB_TX_SEQUENCE_BURST_BYTES * TSUNB_TX_SEQUENCE_MAX_BURSTS> TsUnbTxSequence_t;
+
+//! Command list of the transmit sequencer
+extern TsUnbTxSequence_t TsUnbTxSequence;
+//! Index of the next step of TsUnbTxSequence sent by the timer interrupt
+extern volatile uint16_t TsUnbTxSequenceStep;
+//! The timer interrupt sends the steps of TsUnbTxSequence instead of setting TsUnbTimerFlag
+extern volatile bool TsUnbTxSequencerActive;
+
+/**
+ * @brief Hands the SPI pins to a PIO state machine fed by a DMA channel
+ *
+ * @return false if no PIO state machine or DMA channel is available
+ */
+extern bool tx_sequencer_init();
+
+/**
+ * @brief Waits for the last SPI transaction and hands the pins back to the SPI
+ */
+extern void tx_sequencer_deinit();
+#endif
 
 
 /**
@@ -159,30 +226,34 @@ public:
 	 */
 	static constexpr float TS_UNB_BIT_DURATION_US = (double) 1000000 / (49.591064453125 * (double)SYMBOL_RATE_MULT);
 
+	static_assert(SYMBOL_RATE_MULT <= 5041, "The symbol clock supports SYMBOL_RATE_MULT up to 5041");
+
 
 	/**
 	 * @brief Init the timer
 	 */
 	void initTimer() {
-		preciseTsUnbTimer_us = 0;
-		TsUnbBitDuration_us = TS_UNB_BIT_DURATION_US;
+		TsUnbSymbolClock.init(SYMBOL_RATE_MULT);
 	}
 
 	/**
 	 * @brief Start the timer
 	 */
 	void startTimer() {	
-		if(preciseTsUnbTimer_us == 0){
-			preciseTsUnbTimer_us += TS_UNB_BIT_DURATION_US;
-		}
-
-		ExtraDelaySet = false;
 		TsUnbTimerFlag = false;	
-
-		TsUnbTimeNextCycle_us = (int64_t)(preciseTsUnbTimer_us + 0.5f);
-		preciseTsUnbTimer_us -= (float)TsUnbTimeNextCycle_us;	
-
-		alarm_id = add_alarm_in_us((uint64_t)TsUnbTimeNextCycle_us, timer_callback, NULL, true);
+		const uint32_t firstDelay_us = TsUnbSymbolClock.start();
+
+#ifdef TSUNB_TIMING_STATS
+		TsUnbWakeLatencyMin_us = UINT32_MAX;
+		TsUnbWakeLatencyMax_us = 0;
+		TsUnbTimerInterrupts = 0;
+		TsUnbWaitSleep_us = 0;
+		TsUnbWaitSpin_us = 0;
+		TsUnbWaitWakeUps = 0;
+#endif
+
+		TsUnbTimerNextAt_us = time_us_32() + firstDelay_us;
+		alarm_id = add_alarm_in_us(firstDelay_us, timer_callback, NULL, true);
 	}
 
 
@@ -199,24 +270,51 @@ public:
 	 *
 	 * @param count Delay in TX symbols
 	 */
-	void addTimerDelay(const int32_t count) {
-		TimeAddedDelay = get_absolute_time();
-		preciseTsUnbTimer_us += TS_UNB_BIT_DURATION_US * (count-1);
-		ExtraDelaySet = true;		
+	TSUNB_TIME_CRITICAL void addTimerDelay(const int32_t count) {
+		TsUnbSymbolClock.addDelay(count);
 	}
 
 	/**
 	 * @brief Wait until the timer values expires
+	 *
+	 * Sleeps with __wfe() until the timer interrupt sets the flag and sends an event (__sev()).
+	 * Other interrupts wake the core as well, it goes back to sleep unless the next timer
+	 * interrupt is less than TSUNB_WAIT_SPIN_US away, then it spins on the flag.
+	 * sleep_us() is not used here as it is executed from flash.
 	 */
-	void waitTimer() const {
+	TSUNB_TIME_CRITICAL void waitTimer() const {
 		//TODO check if timer is really running
-		sleep_us(TsUnbTimeNextCycle_us-10);			
-		while (true){
-			if (TsUnbTimerFlag){
-				break;
+#ifdef TSUNB_TIMING_STATS
+		const uint32_t waitStart = time_us_32();
+		uint32_t sleptUs = 0;
+#endif
+		while (!TsUnbTimerFlag) {
+			if ((int32_t) (TsUnbTimerNextAt_us - time_us_32()) > TSUNB_WAIT_SPIN_US) {
+#ifdef TSUNB_TIMING_STATS
+				const uint32_t sleepStart = time_us_32();
+				__wfe();
+				sleptUs += time_us_32() - sleepStart;
+				++TsUnbWaitWakeUps;
+#else
+				__wfe();
+#endif
+			}
+			else {
+				tight_loop_contents();
 			}
 		}
 		TsUnbTimerFlag = false;
+
+#ifdef TSUNB_TIMING_STATS
+		TsUnbWaitSleep_us += sleptUs;
+		TsUnbWaitSpin_us += time_us_32() - waitStart - sleptUs;
+
+		const uint32_t latency = time_us_32() - TsUnbTimerFiredAt_us;
+		if (latency < TsUnbWakeLatencyMin_us)
+			TsUnbWakeLatencyMin_us = latency;
+		if (latency > TsUnbWakeLatencyMax_us)
+			TsUnbWakeLatencyMax_us = latency;
+#endif
 	}
 
 	/**
@@ -252,7 +350,7 @@ public:
 	 * @param dataOut Bytes to be transmitted
 	 * @param numBytes Number of bytes to be transmitted
 	 */
-	void spiSend(const uint8_t* const dataOut, const uint8_t numBytes) {
+	TSUNB_TIME_CRITICAL void spiSend(const uint8_t* const dataOut, const uint8_t numBytes) {
 		gpio_put(Board::GPIO::MIOTY_SPI_CS, 0);
 		spi_write_blocking(SPI_INTERFACE, dataOut, numBytes);
 		gpio_put(Board::GPIO::MIOTY_SPI_CS, 1);
@@ -263,23 +361,57 @@ public:
 	 *
 	 * This method write and reads the SPI data. Please not that the read data has a delay of one byte.
 	 * Hence, the first returned byte normally has no meaning.
+	 * The data is exchanged in place, i.e. without a copy: spi_write_read_blocking() stores
+	 * each received byte only after the byte at the same position was sent.
 	 * 
 	 * @param dataInOut Bytes to be transmitted and buffer containing the read data
 	 * @param numBytes  Number of bytes to be transmitted
 	 */
 	void spiSendReceive(uint8_t* const dataInOut, const uint8_t numBytes) {
-		// Allocate memory as we cannot read write on the same memory
-		uint8_t readData[numBytes];
-
 		gpio_put(Board::GPIO::MIOTY_SPI_CS, 0);
-		spi_write_read_blocking(SPI_INTERFACE, dataInOut, readData, numBytes);
+		spi_write_read_blocking(SPI_INTERFACE, dataInOut, dataInOut, numBytes);
 		gpio_put(Board::GPIO::MIOTY_SPI_CS, 1);
+	}
 
-		for(int i=0;i<numBytes;i++) {
-			dataInOut[i] = readData[i];
-		}
+#ifdef TSUNB_TX_SEQUENCER
+	//! Command list of the transmit sequencer, see Trx::HasTxSequencer
+	typedef TsUnbTxSequence_t TxSequence_t;
+
+	/**
+	 * @brief Get the command list of the transmit sequencer
+	 */
+	TxSequence_t& getTxSequence() {
+		return TsUnbTxSequence;
+	}
+
+	/**
+	 * @brief Sends the command list of getTxSequence() without the CPU
+	 *
+	 * Starts the timer like startTimer(). The SPI pins are driven by a PIO state machine, which
+	 * implements an SPI master incl. the chip select of each transaction. The timer interrupt
+	 * starts one DMA transfer of the transactions of each step into the PIO. The CPU sleeps
+	 * until the interrupt of the last step, the timer has to be stopped with stopTimer().
+	 * Placed in SRAM with TSUNB_TX_IN_RAM; the PIO and DMA setup before the timer starts
+	 * and the release after the last step run from flash.
+	 *
+	 * @return false if the sequencer is not available, nothing has been sent in this case
+	 */
+	TSUNB_TIME_CRITICAL bool runSequence() {
+		if (TsUnbTxSequence.getNumSteps() == 0 || !tx_sequencer_init())
+			return false;
+
+		addTimerDelay(TsUnbTxSequence.getStep(0).delay);
+		TsUnbTxSequenceStep = 0;
+		TsUnbTxSequencerActive = true;
+		startTimer();
+
+		// The interrupt of the last step sets the flag
+		waitTimer();
 
+		tx_sequencer_deinit();
+		return true;
 	}
+#endif
 
 	alarm_id_t alarm_id;	
 
@@ -288,7 +420,7 @@ public:
 	 * @brief Reset watchdog (just stub, not implemented)
 	 * 
 	 */
-	void resetWatchdog() {};
+	TSUNB_TIME_CRITICAL_INLINE void resetWatchdog() {};
 };
 
 
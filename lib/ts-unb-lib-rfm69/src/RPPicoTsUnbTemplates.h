@@ -68,6 +68,9 @@ Am Wolfsmantel 33
 91058 Erlangen, Germany
 ks-contracts@iis.fraunhofer.de
 
+This file is part of a Third-Party Modified Version of the Fraunhofer TS-UNB-Lib.
+Modifications by mioty Alliance e.V. (2025)
+
 ----------------------------------------------------------------------------- */
 
 
@@ -85,6 +88,26 @@ ks-contracts@iis.fraunhofer.de
 
 #include "../Trx/Rfm69hw.h"
 
+/**
+ * @brief MPDU length for which the PHY uses a precomputed interleaver table
+ *
+ * Can be defined by the application if all packets have the same length. 0 disables the table.
+ */
+#ifndef TSUNB_FIXED_MPDU_LENGTH
+#define TSUNB_FIXED_MPDU_LENGTH 0
+#endif
+
+/**
+ * @brief Pre-tuning of the RFM69 between the bursts, see Rfm69hw
+ *
+ * Enabled per board with the CMake option TSUNB_TX_PRETUNE.
+ */
+#ifdef TSUNB_TX_PRETUNE
+#define TSUNB_RFM69_PRETUNE true
+#else
+#define TSUNB_RFM69_PRETUNE false
+#endif
+
 namespace TsUnbLib {
 namespace RPPico {
 
@@ -94,43 +117,43 @@ namespace RPPico {
 
 //! RFM69w in EU0 configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU0_Rfm69w_t;
+	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU0_Rfm69w_t;
 
 //! RFM69w in EU1 configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU1_Rfm69w_t;
+	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU1_Rfm69w_t;
 
 //! RFM69w in EU2 configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU2_Rfm69w_t;
+	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU2_Rfm69w_t;
 
 //! RFM69w in US0 configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2> >, true> TsUnb_US0_Rfm69w_t;
+	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, true> TsUnb_US0_Rfm69w_t;
 
 //! RFM69w in EU0 Low Latency configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU0_LowLatency_Rfm69w_t;
+	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU0_LowLatency_Rfm69w_t;
 
 //! RFM69w in EU1 Low Latency configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU1_LowLatency_Rfm69w_t;
+	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU1_LowLatency_Rfm69w_t;
 
 //! RFM69w in EU2 Low Latency configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU2_LowLatency_Rfm69w_t;
+	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU2_LowLatency_Rfm69w_t;
 
 //! RFM69w in US0 Low Latency configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2> >, true> TsUnb_US0_LowLatency_Rfm69w_t;
+	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, false, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, true> TsUnb_US0_LowLatency_Rfm69w_t;
 
 
 
@@ -140,43 +163,43 @@ typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
 
 //! RFM69hw in EU0 configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU0_Rfm69hw_t;
+	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU0_Rfm69hw_t;
 
 //! RFM69hw in EU1 configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU1_Rfm69hw_t;
+	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU1_Rfm69hw_t;
 
 //! RFM69hw in EU2 configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU2_Rfm69hw_t;
+	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU2_Rfm69hw_t;
 
 //! RFM69hw in US0 configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, true> TsUnb_US0_Rfm69hw_t;
+	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, true> TsUnb_US0_Rfm69hw_t;
 
 //! RFM69hw in EU0 Low Latency configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU0_LowLatency_Rfm69hw_t;
+	TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU0_LowLatency_Rfm69hw_t;
 
 //! RFM69hw in EU1 Low Latency configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU1_LowLatency_Rfm69hw_t;
+	TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU1_LowLatency_Rfm69hw_t;
 
 //! RFM69hw in EU2 Low Latency configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, false> TsUnb_EU2_LowLatency_Rfm69hw_t;
+	TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, false> TsUnb_EU2_LowLatency_Rfm69hw_t;
 
 //! RFM69hw in US0 Low Latency configuration
 typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac, 
-	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2> >,
-	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2> >, true> TsUnb_US0_LowLatency_Rfm69hw_t;
+	TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst <2,2>, TSUNB_FIXED_MPDU_LENGTH>,
+	Trx::Rfm69hw<RPPicoTsUnb<48>, true, 10, TsUnb::RadioBurst <2,2>, TSUNB_RFM69_PRETUNE>, true> TsUnb_US0_LowLatency_Rfm69hw_t;
 
 
 
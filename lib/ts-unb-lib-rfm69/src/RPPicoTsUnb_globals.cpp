@@ -83,35 +83,214 @@ Modifications by mioty Alliance e.V. (2025)
 
 #include "RPPicoTsUnb.h"
 
+#ifdef TSUNB_TX_SEQUENCER
+#include <hardware/clocks.h>
+#include <hardware/dma.h>
+#include <hardware/pio.h>
+#endif
+
+/*
+ * Functions of the transmit hot path are placed in SRAM if TSUNB_TX_IN_RAM is defined. They use
+ * their own sections: a non-inline function must not share the section of the inline
+ * TSUNB_TIME_CRITICAL functions.
+ */
+#ifdef TSUNB_TX_IN_RAM
+#define TSUNB_ISR_FUNC(func)	__not_in_flash_func(func)
+#else
+#define TSUNB_ISR_FUNC(func)	func
+#endif
+
 namespace TsUnbLib {
 namespace RPPico {
 
 //! Flag to indicate end of timer
-volatile absolute_time_t TimeAddedDelay;
 volatile bool TsUnbTimerFlag;
-volatile bool ExtraDelaySet;
-volatile float preciseTsUnbTimer_us;
-volatile float TsUnbBitDuration_us;
-volatile int64_t TsUnbTimeNextCycle_us;
+TsUnb::SymbolClock TsUnbSymbolClock;
+volatile uint32_t TsUnbTimerNextAt_us;
+
+#ifdef TSUNB_TIMING_STATS
+volatile uint32_t TsUnbTimerFiredAt_us;
+volatile uint32_t TsUnbWakeLatencyMin_us;
+volatile uint32_t TsUnbWakeLatencyMax_us;
+volatile uint32_t TsUnbTimerInterrupts;
+volatile uint32_t TsUnbWaitSleep_us;
+volatile uint32_t TsUnbWaitSpin_us;
+volatile uint32_t TsUnbWaitWakeUps;
+#endif
+
+#ifdef TSUNB_TX_SEQUENCER
+TsUnbTxSequence_t TsUnbTxSequence;
+volatile uint16_t TsUnbTxSequenceStep;
+volatile bool TsUnbTxSequencerActive;
+
+//! PIO, state machine, program offset and DMA channel of the sequencer
+static PIO txSequencerPio;
+static int txSequencerSm = -1;
+static uint txSequencerOffset;
+static int txSequencerDma = -1;
+
+/*
+ * PIO SPI master (mode 0, MSB first) with chip select. Each transaction is written to the
+ * TX FIFO as its length in bytes followed by the bytes, one byte per FIFO entry, i.e. the
+ * format of Trx::TxSequence. Side-set: SCK, set pin: CS, out pin: MOSI. One SCK period
+ * takes 4 cycles.
+ */
+static const uint16_t txSequencerInstructions[] = {
+			//     .wrap_target
+	0x80a0,	//  0: pull   block           side 0		; transaction length
+	0x6028,	//  1: out    x, 8            side 0
+	0xe000,	//  2: set    pins, 0         side 0		; CS low
+	0x0044,	//  3: jmp    x--, 4          side 0		; x = length - 1
+	0x80a0,	//  4: pull   block           side 0		; next byte
+	0xe047,	//  5: set    y, 7            side 0
+	0x6101,	//  6: out    pins, 1         side 0 [1]
+	0x1186,	//  7: jmp    y--, 6          side 1 [1]
+	0x0044,	//  8: jmp    x--, 4          side 0
+	0xe101,	//  9: set    pins, 1         side 0 [1]	; CS high
+			//     .wrap
+};
+
+static const pio_program_t txSequencerProgram = {
+	txSequencerInstructions,
+	sizeof(txSequencerInstructions) / sizeof(txSequencerInstructions[0]),
+	-1,		// relocatable
+	0,		// PIO version 0 (RP2040)
+#if PICO_PIO_VERSION > 0
+	0,		// no GPIO range restrictions
+#endif
+};
+
+bool tx_sequencer_init() {
+	const PIO pios[] = {pio0, pio1};
+	for (const PIO pio : pios) {
+		if (!pio_can_add_program(pio, &txSequencerProgram))
+			continue;
+		txSequencerSm = pio_claim_unused_sm(pio, false);
+		if (txSequencerSm >= 0) {
+			txSequencerPio = pio;
+			break;
+		}
+	}
+	if (txSequencerSm < 0)
+		return false;
+
+	txSequencerDma = dma_claim_unused_channel(false);
+	if (txSequencerDma < 0) {
+		pio_sm_unclaim(txSequencerPio, txSequencerSm);
+		txSequencerSm = -1;
+		return false;
+	}
+
+	const PIO pio = txSequencerPio;
+	const uint sm = txSequencerSm;
+	txSequencerOffset = pio_add_program(pio, &txSequencerProgram);
+
+	pio_sm_config config = pio_get_default_sm_config();
+	sm_config_set_wrap(&config, txSequencerOffset, txSequencerOffset + txSequencerProgram.length - 1);
+	sm_config_set_sideset(&config, 1, false, false);
+	sm_config_set_sideset_pins(&config, Board::GPIO::MIOTY_SPI_SCK);
+	sm_config_set_out_pins(&config, Board::GPIO::MIOTY_SPI_MOSI, 1);
+	sm_config_set_set_pins(&config, Board::GPIO::MIOTY_SPI_CS, 1);
+	// Bytes are replicated over the FIFO word, the MSB is shifted out first
+	sm_config_set_out_shift(&config, false, false, 32);
+	sm_config_set_fifo_join(&config, PIO_FIFO_JOIN_TX);
+	sm_config_set_clkdiv(&config, (float) clock_get_hz(clk_sys) / (4.0f * SPI_BAUDRATE));
+
+	// CS stays high and SCK low while the pins are handed over
+	const uint32_t pinMask = (1u << Board::GPIO::MIOTY_SPI_SCK) | (1u << Board::GPIO::MIOTY_SPI_MOSI)
+			| (1u << Board::GPIO::MIOTY_SPI_CS);
+	pio_sm_set_pins_with_mask(pio, sm, 1u << Board::GPIO::MIOTY_SPI_CS, pinMask);
+	pio_sm_set_pindirs_with_mask(pio, sm, pinMask, pinMask);
+	pio_gpio_init(pio, Board::GPIO::MIOTY_SPI_CS);
+	pio_gpio_init(pio, Board::GPIO::MIOTY_SPI_SCK);
+	pio_gpio_init(pio, Board::GPIO::MIOTY_SPI_MOSI);
+
+	pio_sm_init(pio, sm, txSequencerOffset, &config);
+	pio_sm_set_enabled(pio, sm, true);
+
+	dma_channel_config dmaConfig = dma_channel_get_default_config(txSequencerDma);
+	channel_config_set_transfer_data_size(&dmaConfig, DMA_SIZE_8);
+	channel_config_set_read_increment(&dmaConfig, true);
+	channel_config_set_write_increment(&dmaConfig, false);
+	channel_config_set_dreq(&dmaConfig, pio_get_dreq(pio, sm, true));
+	dma_channel_configure(txSequencerDma, &dmaConfig, &pio->txf[sm], NULL, 0, false);
+
+	return true;
+}
+
+void tx_sequencer_deinit() {
+	const PIO pio = txSequencerPio;
+	const uint sm = txSequencerSm;
+
+	// The last transaction is complete when the state machine waits for the next length
+	while (dma_channel_is_busy(txSequencerDma) || !pio_sm_is_tx_fifo_empty(pio, sm)
+			|| pio_sm_get_pc(pio, sm) != txSequencerOffset) {
+		tight_loop_contents();
+	}
+
+	pio_sm_set_enabled(pio, sm, false);
+	pio_remove_program(pio, &txSequencerProgram, txSequencerOffset);
+	pio_sm_unclaim(pio, sm);
+	dma_channel_unclaim(txSequencerDma);
+	txSequencerSm = -1;
+	txSequencerDma = -1;
+
+	gpio_set_function(Board::GPIO::MIOTY_SPI_SCK, GPIO_FUNC_SPI);
+	gpio_set_function(Board::GPIO::MIOTY_SPI_MOSI, GPIO_FUNC_SPI);
+	gpio_set_function(Board::GPIO::MIOTY_SPI_CS, GPIO_FUNC_SIO);
+}
 
 /**
- * @brief Interrupt function for compare match of timer to set TimerFlag
+ * @brief Sends the transactions of the current step and schedules the next step
+ *
+ * Called by the timer interrupt at the end of the delay of the step.
  */
-int64_t timer_callback(alarm_id_t id, void *user_data) {
+static void TSUNB_ISR_FUNC(tx_sequencer_step)() {
+	const uint16_t stepIdx = TsUnbTxSequenceStep;
+	const TsUnbTxSequence_t::Step& step = TsUnbTxSequence.getStep(stepIdx);
+	if (step.frameLength != 0)
+		dma_channel_transfer_from_buffer_now(txSequencerDma, TsUnbTxSequence.getFrames(step), step.frameLength);
 
-	if(!ExtraDelaySet) { //fire and then reload timer for next cycle
+	// The next interrupt is the next step, there is no interrupt in between
+	if (stepIdx + 1 < TsUnbTxSequence.getNumSteps()) {
+		TsUnbTxSequenceStep = stepIdx + 1;
+		TsUnbSymbolClock.extendPeriod(TsUnbTxSequence.getStep(stepIdx + 1).delay);
+	}
+	else {
+		// Wake up runSequence()
+		TsUnbTxSequencerActive = false;
 		TsUnbTimerFlag = true;
-		preciseTsUnbTimer_us += TsUnbBitDuration_us;
-		TsUnbTimeNextCycle_us = (int64_t)(preciseTsUnbTimer_us + 0.5f);
-		preciseTsUnbTimer_us -= (float)TsUnbTimeNextCycle_us;		
 	}
-	else { //AddTimerDelay has already calculated, just adjusting the time
-		TsUnbTimeNextCycle_us = (int64_t)(preciseTsUnbTimer_us + 0.5f);
-		preciseTsUnbTimer_us -= (float)TsUnbTimeNextCycle_us;	
-		ExtraDelaySet = false;
+}
+#endif
+
+/**
+ * @brief Interrupt function for compare match of timer to set TimerFlag
+ *
+ * Part of the transmit hot path, placed in SRAM if TSUNB_TX_IN_RAM is defined.
+ */
+int64_t TSUNB_ISR_FUNC(timer_callback)(alarm_id_t id, void *user_data) {
+#ifdef TSUNB_TIMING_STATS
+	TsUnbTimerFiredAt_us = time_us_32();
+	++TsUnbTimerInterrupts;
+#endif
+
+	// Integer only: either the end of a symbol period or of the delay set by addTimerDelay()
+	if (TsUnbSymbolClock.tick()) {
+#ifdef TSUNB_TX_SEQUENCER
+		if (TsUnbTxSequencerActive)
+			tx_sequencer_step();
+		else
+#endif
+			TsUnbTimerFlag = true;
 	}
 
-	return -TsUnbTimeNextCycle_us; 	// Negative menas that delay between calls will be kept regardless of callback time 
+	// Wakes up waitTimer() also if the flag was set just before its __wfe()
+	__sev();
+
+	const uint32_t next_us = TsUnbSymbolClock.getNextUs();
+	TsUnbTimerNextAt_us += next_us;
+	return -(int64_t)next_us; 	// Negative means that delay between calls will be kept regardless of callback time 
 }
 
 } // namespace RPPico
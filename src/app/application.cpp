@@ -94,6 +94,7 @@ Modifications by mioty Alliance e.V. (2025)
 Application::Application()
     : m_board_config()
     , m_ts_unb_driver()
+    , m_payload_builder(m_ts_unb_driver.getPayloadBuffer(), TSUNBDriver::MAX_PAYLOAD_LENGTH)
     , m_last_sensor_reading_time(0)
     , m_last_transmission_time(0)
     , m_sensor_data({0.0f})
@@ -426,8 +427,8 @@ void Application::transmitData() {
     Logger::debug("Sensor data bytes: [8]=0x%02X [9]=0x%02X (temperature: %.2f°C)", 
                   payload_data[8], payload_data[9], m_sensor_data.temperature);
     
-    // Send the binary data via TS-UNB
-    TSUNBStatus status = m_ts_unb_driver.sendData(payload_data, payload_length);
+    // Send the binary data via TS-UNB, the payload is already in the MPDU buffer of the driver
+    TSUNBStatus status = m_ts_unb_driver.sendPayload(payload_length);
     
     if (status == TSUNBStatus::OK) {
         Logger::info("✓ MIOTY transmission successful (packet #%u)", m_packet_counter);
@@ -10,7 +10,7 @@
 #pragma once
 
 #include "board_config.hpp"
-#include "../../drivers/mioty/ts_unb_driver.hpp"
+#include "../../drivers/mioty/ts_unb_types.hpp"
 
 namespace Config {
     // Application version
@@ -55,8 +55,9 @@ namespace Config {
                                            0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
         
         // Radio configuration using proper enum types
-        constexpr TSUNBDriver::Region REGION = TSUNBDriver::Region::EU1;
-        constexpr TSUNBDriver::ChipType CHIP_TYPE = TSUNBDriver::ChipType::RFM69HW;
+        // The TS-UNB driver instantiates only the node type of this region and chip
+        constexpr TSUNBRegion REGION = TSUNBRegion::EU1;
+        constexpr TSUNBChipType CHIP_TYPE = TSUNBChipType::RFM69HW;
         constexpr uint8_t TX_POWER_DBM = 14;                // TX power in dBm (max 14 for RFM69HW in EU)
         
         // Protocol configuration
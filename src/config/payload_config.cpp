@@ -13,17 +13,19 @@
 
 namespace PayloadConfig {
 
-PayloadBuilder::PayloadBuilder() 
-    : m_payload_size(0)
+PayloadBuilder::PayloadBuilder(uint8_t* buffer, size_t capacity) 
+    : m_payload_buffer(buffer)
+    , m_capacity(std::min(capacity, MAX_PAYLOAD_SIZE))
+    , m_payload_size(0)
     , m_trigger_type(CurrentConfig::DEFAULT_TRIGGER)
 {
-    memset(m_payload_buffer, 0, sizeof(m_payload_buffer));
+    memset(m_payload_buffer, 0, m_capacity);
 }
 
 void PayloadBuilder::reset() {
     m_payload_size = 0;
     m_trigger_type = CurrentConfig::DEFAULT_TRIGGER;
-    memset(m_payload_buffer, 0, sizeof(m_payload_buffer));
+    memset(m_payload_buffer, 0, m_capacity);
 }
 
 void PayloadBuilder::setTrigger(TriggerType trigger) {
@@ -80,9 +82,9 @@ bool PayloadBuilder::addRawSensorData(SensorType sensor_type, const uint8_t* dat
     return true;
 }
 
-const uint8_t* PayloadBuilder::getPayload(uint8_t tx_power_dbm, size_t* length_out) const {
+const uint8_t* PayloadBuilder::getPayload(uint8_t tx_power_dbm, size_t* length_out) {
     // Write header at the beginning (this is safe because we reserved space)
-    const_cast<PayloadBuilder*>(this)->writeHeader(tx_power_dbm);
+    writeHeader(tx_power_dbm);
     
     if (length_out) {
         *length_out = m_payload_size;
@@ -92,7 +94,7 @@ const uint8_t* PayloadBuilder::getPayload(uint8_t tx_power_dbm, size_t* length_o
 }
 
 bool PayloadBuilder::hasSpace(size_t bytes_needed) const {
-    return (m_payload_size + bytes_needed) <= MAX_PAYLOAD_SIZE;
+    return (m_payload_size + bytes_needed) <= m_capacity;
 }
 
 void PayloadBuilder::writeHeader(uint8_t tx_power_dbm) {
@@ -191,16 +193,5 @@ const char* sensorTypeToString(PayloadConfig::SensorType sensor) {
     }
 }
 
-size_t calculateExpectedPayloadSize() {
-    size_t size = PayloadConfig::PayloadHeader::SIZE;
-    
-    // Add size for each configured sensor (just the data, no sensor entry headers)
-    for (size_t i = 0; i < PayloadConfig::CurrentConfig::SENSOR_COUNT; i++) {
-        size += PayloadConfig::CurrentConfig::SENSOR_CONFIGS[i].data_length;
-    }
-    
-    return size;
-}
-
 } // namespace Utils
 } // namespace PayloadConfig
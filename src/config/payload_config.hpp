@@ -99,7 +99,12 @@ namespace PayloadConfig {
     // Helper functions for payload assembly and parsing
     class PayloadBuilder {
     public:
-        PayloadBuilder();
+        /**
+         * @brief Construct a builder which assembles the payload in an external buffer
+         * @param buffer Payload buffer, e.g. the MPDU payload region of TSUNBDriver
+         * @param capacity Size of the buffer in bytes, limited to MAX_PAYLOAD_SIZE
+         */
+        PayloadBuilder(uint8_t* buffer, size_t capacity);
         ~PayloadBuilder() = default;
         
         /**
@@ -134,9 +139,9 @@ namespace PayloadConfig {
          * @brief Finalize the payload and get the complete data buffer
          * @param tx_power_dbm Current TX power setting to include in header
          * @param length_out Output parameter for payload length
-         * @return Pointer to payload data buffer
+         * @return Pointer to payload data buffer, i.e. the buffer passed to the constructor
          */
-        const uint8_t* getPayload(uint8_t tx_power_dbm, size_t* length_out) const;
+        const uint8_t* getPayload(uint8_t tx_power_dbm, size_t* length_out);
         
         /**
          * @brief Get current payload size
@@ -152,7 +157,8 @@ namespace PayloadConfig {
         bool hasSpace(size_t bytes_needed) const;
         
     private:
-        uint8_t m_payload_buffer[MAX_PAYLOAD_SIZE];
+        uint8_t* m_payload_buffer;
+        size_t m_capacity;
         size_t m_payload_size;
         TriggerType m_trigger_type;
         
@@ -200,6 +206,15 @@ namespace PayloadConfig {
          * @brief Calculate expected payload size for current configuration
          * @return Expected payload size in bytes
          */
-        size_t calculateExpectedPayloadSize();
+        constexpr size_t calculateExpectedPayloadSize() {
+            size_t size = PayloadHeader::SIZE;
+            
+            // Add size for each configured sensor (just the data, no sensor entry headers)
+            for (size_t i = 0; i < CurrentConfig::SENSOR_COUNT; i++) {
+                size += CurrentConfig::SENSOR_CONFIGS[i].data_length;
+            }
+            
+            return size;
+        }
     }
 }
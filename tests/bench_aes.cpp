@@ -0,0 +1,141 @@
+/**
+ * @file bench_aes.cpp
+ * @brief Microbenchmark of the AES-128 implementations of the TS-UNB-Lib
+ * 
+ * Compares the key expansion and the encryption of one block of the byte
+ * oriented Aes128Compact and the word oriented Aes128TTable. On the host
+ * the AES-NI backend of Aes128Host is measured as well,
+ * including the cost per block of chipherBlocks() for 64 blocks.
+ * 
+ * On the host the results are reported in ns. When built for the RP2040
+ * (PICO_ON_DEVICE) the results are reported in CPU cycles measured with
+ * SysTick and printed via stdio. The firmware build has the targets
+ * bench_aes_rp2040 (T-table in flash) and bench_aes_rp2040_ram
+ * (TSUNB_TABLES_IN_RAM, T-table in SRAM).
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/Encryption/Aes128.h"
+#include "../lib/ts-unb-lib-rfm69/Encryption/Aes128TTable.h"
+#if !(defined(PICO_ON_DEVICE) && PICO_ON_DEVICE)
+#include "../lib/ts-unb-lib-rfm69/Encryption/Aes128Host.h"
+#endif
+#include <cstdio>
+#include <cstdint>
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#define BENCH_UNIT "cyc"
+#else
+#include <chrono>
+#define BENCH_UNIT "ns"
+#endif
+
+using namespace TsUnbLib;
+
+static const uint32_t ITERATIONS = 20000;
+
+// Prevents the compiler from removing the benchmarked code
+static volatile uint32_t g_sink;
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+// Returns the CPU cycles per call, each call is measured individually
+// as the 24 bit SysTick counter would overflow for the complete loop
+template <typename F>
+static double measure(F func) {
+    uint64_t cycles = 0;
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        const uint32_t start = systick_hw->cvr;
+        func(i);
+        const uint32_t stop = systick_hw->cvr;
+        cycles += (start - stop) & 0x00FFFFFF;  // SysTick counts down
+    }
+    return (double)cycles / ITERATIONS;
+}
+#else
+// Returns the time per call in ns
+template <typename F>
+static double measure(F func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        func(i);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ITERATIONS;
+}
+#endif
+
+static const uint8_t KEY[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+
+// Returns the cost per block of chipherBlocks() for 64 independent blocks
+template <class AES>
+static auto measureBlocks(const AES& aes, int) -> decltype(aes.chipherBlocks(nullptr, nullptr, 0), 0.0) {
+    static uint8_t blocks[64 * 16];
+    return measure([&](uint32_t i) {
+        blocks[0] = (uint8_t)i;
+        aes.chipherBlocks(blocks, blocks, 64);
+        g_sink = blocks[0];
+    }) / 64;
+}
+
+// Backends without a const chipherBlocks(), e.g. Aes128Compact
+template <class AES>
+static double measureBlocks(const AES&, long) {
+    return 0;
+}
+
+template <class AES>
+static void benchAes(const char* name, bool multiBlock = false) {
+    uint8_t key[16];
+    for (uint8_t i = 0; i < 16; i++) {
+        key[i] = KEY[i];
+    }
+
+    AES aes;
+    const double t_init = measure([&](uint32_t i) {
+        key[0] = (uint8_t)i;
+        aes.init(key);
+        g_sink = i;
+    });
+
+    uint8_t block[16] = {0};
+    const double t_block = measure([&](uint32_t) {
+        aes.chipher(block, block);
+        g_sink = block[0];
+    });
+
+    printf("  %-16s %12.1f %12.1f", name, t_init, t_block);
+    if (multiBlock) {
+        printf(" %12.1f", measureBlocks(aes, 0));
+    }
+    printf("\n");
+}
+
+int main() {
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    stdio_init_all();
+    sleep_ms(2000);  // Give the USB serial connection time to come up
+
+    // SysTick counts the processor clock, full 24 bit range
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+#endif
+
+    printf("=== TS-UNB AES-128 Benchmark ===\n\n");
+    printf("  %-16s %12s %12s %12s\n", "", "init [" BENCH_UNIT "]", "block [" BENCH_UNIT "]", "64 blk/blk");
+    benchAes<TsUnb::Aes128Compact>("compact");
+    benchAes<TsUnb::Aes128TTable>("T-table", true);
+#if !(defined(PICO_ON_DEVICE) && PICO_ON_DEVICE)
+#if defined(TSUNB_AES_HOST_AESNI)
+    if (TsUnb::Aes128AesNi::supported()) {
+        benchAes<TsUnb::Aes128AesNi>("AES-NI", true);
+    }
+#endif
+#endif
+    return 0;
+}
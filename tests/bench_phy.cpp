@@ -0,0 +1,447 @@
+/**
+ * @file bench_phy.cpp
+ * @brief Microbenchmark of the TS-UNB PHY encoder stages
+ * 
+ * Compares the optimized PHY building blocks with the bit serial
+ * implementations they replace.
+ * 
+ * On the host the results are reported in ns. When built for the RP2040
+ * (PICO_ON_DEVICE, target bench_phy_rp2040 of the firmware build) the results
+ * are reported in CPU cycles measured with SysTick and printed via stdio.
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/TsUnb/RadioBurst.h"
+#include "../lib/ts-unb-lib-rfm69/TsUnb/Phy.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "pico/stdlib.h"
+#include "hardware/structs/systick.h"
+#define BENCH_UNIT "cyc"
+#else
+#include <chrono>
+#define BENCH_UNIT "ns"
+#endif
+
+using namespace TsUnbLib;
+
+static const uint16_t MPDU_LENGTHS[] = {10, 20, 32, 64, 128, 192, 255};
+static const uint32_t ITERATIONS = 20000;
+
+// Prevents the compiler from removing the benchmarked code
+static volatile uint32_t g_sink;
+
+// Bit serial CRC8 as originally implemented in Phy::calcCRC8()
+static uint8_t bitwiseCRC8(const uint8_t* input, uint16_t num_bits) {
+    uint8_t crc = TSUNBPHY_CRC8_INIT;
+    for (uint16_t i = 0; i < num_bits; i++) {
+        uint8_t msb = (crc & 0x80) ? 1 : 0;
+        msb ^= readBit(i, input);
+        crc <<= 1;
+        if (msb) {
+            crc ^= TSUNBPHY_CRC8_POLY;
+        }
+    }
+    return crc;
+}
+
+static uint8_t tableCRC8(const uint8_t* input, uint16_t num_bits) {
+    return Crc8<TsUnb::TSUNBPHY_CRC8_TABLE>::calc(TSUNBPHY_CRC8_INIT, input, num_bits);
+}
+
+// Bit serial whitening as originally implemented in Phy::whitenData()
+static void lfsrWhitening(uint8_t* data, uint16_t num_bytes) {
+    uint16_t reg = 0x1FF;
+    for (uint16_t byte = 0; byte < num_bytes; byte++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            reg <<= 1;
+            reg ^= 0x1 & (reg >> 9 ^ reg >> 4);
+        }
+        data[byte] ^= (uint8_t)reg;
+    }
+}
+
+static void tableWhitening(uint8_t* data, uint16_t num_bytes) {
+    uint16_t byte = 0;
+    for (; byte + 4 <= num_bytes; byte += 4) {
+        uint32_t word, sequence;
+        memcpy(&word, &data[byte], 4);
+        memcpy(&sequence, &TsUnb::TSUNBPHY_WHITENING_SEQUENCE.entry[byte], 4);
+        word ^= sequence;
+        memcpy(&data[byte], &word, 4);
+    }
+    // At most 3 remaining bytes
+    for (uint8_t i = 0; i < (num_bytes & 0x03); i++) {
+        data[byte + i] ^= TsUnb::TSUNBPHY_WHITENING_SEQUENCE.entry[byte + i];
+    }
+}
+
+static uint8_t parity(uint8_t reg) {
+    reg ^= reg >> 4;
+    reg ^= reg >> 2;
+    reg ^= reg >> 1;
+    return reg & 1;
+}
+
+// Bit serial convolutional encoder as originally implemented in Phy::encode()
+static uint32_t bitwiseConvolution(const uint8_t* data, uint16_t num_bytes) {
+    uint8_t reg = data[num_bytes - 1];
+    uint32_t check = 0;
+    for (uint16_t i = 0; i < num_bytes * 8; i++) {
+        reg = (uint8_t)(reg << 1) | readBit(i, data);
+        check ^= parity(TSUNBPHY_CONV_POLY_G1 & reg) << (i % 32);
+        check ^= parity(TSUNBPHY_CONV_POLY_G2 & reg) << ((i + 1) % 32);
+        check ^= parity(TSUNBPHY_CONV_POLY_G3 & reg) << ((i + 2) % 32);
+    }
+    return check;
+}
+
+static uint32_t tableConvolution(const uint8_t* data, uint16_t num_bytes) {
+    ConvEncoder<TsUnb::TSUNBPHY_CONV_TABLES> encoder(data[num_bytes - 1]);
+    uint32_t check = 0;
+    for (uint16_t i = 0; i < num_bytes; i++) {
+        check ^= encoder.encodeByte(data[i]);
+    }
+    return check;
+}
+
+// Radio burst filled bit by bit as originally implemented in RadioBurst
+struct LegacyRadioBurst {
+    static const uint16_t BURST_LENGTH_BYTES = 5;
+    uint8_t data[BURST_LENGTH_BYTES] = {0};
+    uint16_t T_RB = 0;
+
+    const uint8_t* getBurst() const { return data; }
+
+    void writeSubPacketBit(uint8_t bit, uint16_t burstIdx) {
+        const uint16_t bitIdx = ((burstIdx ^ T_RB) & 1) ? 24 + (T_RB >> 1) : 11 - (T_RB >> 1);
+        writeBit(bit, bitIdx + 2, data);
+        T_RB++;
+    }
+
+    void addMidamble(uint16_t burstIdx) {
+        const uint16_t midamble = burstIdx < TSUNB_RADIO_BURST_CORE_BURSTS ?
+                TSUNB_RADIO_BURST_MIDAMBLE_CORE : TSUNB_RADIO_BURST_MIDAMBLE_EXT;
+        for (uint16_t i = 0; i < 12; i++) {
+            writeBit((midamble >> (11 - i)) & 1, 12 + 2 + i, data);
+        }
+    }
+
+    void differentialMSKEncoding() {
+        uint8_t firstBitLastByte = 0;
+        for (uint16_t s = 0; s < BURST_LENGTH_BYTES; ++s) {
+            const uint8_t shiftedData = firstBitLastByte | (data[s] >> 1);
+            firstBitLastByte = data[s] << 7;
+            data[s] ^= shiftedData;
+        }
+        data[0] |= 0x80;
+    }
+};
+
+// Sums up the data of all bursts to keep the compiler from removing unused bursts
+template <class BURST>
+static uint32_t burstSum(const BURST* bursts, uint16_t num_bursts) {
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < num_bursts; i++) {
+        for (uint16_t j = 0; j < 5; j++) {
+            sum += bursts[i].getBurst()[j];
+        }
+    }
+    return sum;
+}
+
+// The bursts of the longest packet do not fit on the RP2040 stack (2 kB), the benchmarks use
+// static bursts and reset the bursts of the current packet instead of constructing new ones
+template <class BURST>
+static BURST* resetBursts(BURST* bursts, uint16_t num_bursts) {
+    for (uint16_t i = 0; i < num_bursts; i++) {
+        bursts[i] = BURST();
+    }
+    return bursts;
+}
+
+// Fills all bursts of a packet with coded bits, the coded bits are distributed
+// round robin over the bursts, which has the same cost as the actual interleaver
+static uint32_t legacyFill(uint16_t num_bursts, const uint8_t* coded) {
+    static LegacyRadioBurst storage[TSUNBPHY_MAX_NUM_BURSTS];
+    LegacyRadioBurst* const bursts = resetBursts(storage, num_bursts);
+    uint16_t burstIdx = 0;
+    for (uint16_t i = 0; i < num_bursts * TSUNB_RADIO_BURST_DATA_LEN; i++) {
+        bursts[burstIdx].writeSubPacketBit((coded[i >> 3] >> (i & 7)) & 1, burstIdx);
+        if (++burstIdx == num_bursts)
+            burstIdx = 0;
+    }
+    for (uint16_t burstIdx = 0; burstIdx < num_bursts; burstIdx++) {
+        bursts[burstIdx].addMidamble(burstIdx);
+        bursts[burstIdx].differentialMSKEncoding();
+    }
+    return burstSum(bursts, num_bursts);
+}
+
+// Same as legacyFill(), the bits are collected in the subpacket registers like in Phy::encode()
+static uint32_t registerFill(uint16_t num_bursts, const uint8_t* coded) {
+    static TsUnb::RadioBurst<2, 2> storage[TSUNBPHY_MAX_NUM_BURSTS];
+    TsUnb::RadioBurst<2, 2>* const bursts = resetBursts(storage, num_bursts);
+    uint32_t subPacketBits[TSUNBPHY_MAX_NUM_BURSTS] = {0};
+    uint16_t burstIdx = 0;
+    for (uint16_t i = 0; i < num_bursts * TSUNB_RADIO_BURST_DATA_LEN; i++) {
+        bursts[burstIdx].writeSubPacketBit((coded[i >> 3] >> (i & 7)) & 1, burstIdx, subPacketBits[burstIdx]);
+        if (++burstIdx == num_bursts)
+            burstIdx = 0;
+    }
+    for (burstIdx = 0; burstIdx < num_bursts; burstIdx++) {
+        bursts[burstIdx].commitSubPacket(burstIdx, subPacketBits[burstIdx]);
+    }
+    return burstSum(bursts, num_bursts);
+}
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+// Returns the CPU cycles per call, each call is measured individually
+// as the 24 bit SysTick counter would overflow for the complete loop
+template <typename F>
+static double measure(F func) {
+    uint64_t cycles = 0;
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        const uint32_t start = systick_hw->cvr;
+        func(i);
+        const uint32_t stop = systick_hw->cvr;
+        cycles += (start - stop) & 0x00FFFFFF;  // SysTick counts down
+    }
+    return (double)cycles / ITERATIONS;
+}
+#else
+// Returns the time per call in ns
+template <typename F>
+static double measure(F func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < ITERATIONS; i++) {
+        func(i);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / ITERATIONS;
+}
+#endif
+
+static void benchCRC8() {
+    printf("CRC8 (payload CRC + header CRC per packet)\n");
+    printf("  MPDU   bitwise [" BENCH_UNIT "]  table [" BENCH_UNIT "]   speedup\n");
+
+    uint8_t psdu[TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD];
+    for (size_t i = 0; i < sizeof(psdu); i++) {
+        psdu[i] = (uint8_t)(i * 73 + 41);
+    }
+
+    for (uint16_t len : MPDU_LENGTHS) {
+        const uint16_t payload_bits = len * 8 + 2;
+        const double t_bitwise = measure([&](uint32_t i) {
+            psdu[0] = (uint8_t)i;
+            g_sink = bitwiseCRC8(&psdu[TSUNBPHY_PAYLOAD_DATA_POS], payload_bits) +
+                     bitwiseCRC8(&psdu[TSUNBPHY_PAYLOAD_CRC_POS], 16);
+        });
+        const double t_table = measure([&](uint32_t i) {
+            psdu[0] = (uint8_t)i;
+            g_sink = tableCRC8(&psdu[TSUNBPHY_PAYLOAD_DATA_POS], payload_bits) +
+                     tableCRC8(&psdu[TSUNBPHY_PAYLOAD_CRC_POS], 16);
+        });
+        printf("  %4u   %12.1f   %10.1f   %6.1fx\n", len, t_bitwise, t_table, t_bitwise / t_table);
+    }
+}
+
+static void benchWhitening() {
+    printf("Whitening (complete PSDU per packet)\n");
+    printf("  MPDU      LFSR [" BENCH_UNIT "]  table [" BENCH_UNIT "]   speedup\n");
+
+    alignas(4) uint8_t psdu[TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD] = {0};
+
+    for (uint16_t len : MPDU_LENGTHS) {
+        const uint16_t num_bytes = len + TSUNBPHY_OVERHEAD;
+        const double t_lfsr = measure([&](uint32_t) {
+            lfsrWhitening(psdu, num_bytes);
+            g_sink = psdu[num_bytes - 1];
+        });
+        const double t_table = measure([&](uint32_t) {
+            tableWhitening(psdu, num_bytes);
+            g_sink = psdu[num_bytes - 1];
+        });
+        printf("  %4u   %12.1f   %10.1f   %6.1fx\n", len, t_lfsr, t_table, t_lfsr / t_table);
+    }
+}
+
+static void benchBurstFill() {
+    static uint8_t coded[(TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD) * TSUNB_RADIO_BURST_DATA_LEN / 8];
+    for (uint16_t i = 0; i < sizeof(coded); i++) {
+        coded[i] = (uint8_t)(i * 29 + 7);
+    }
+
+    printf("Radio burst fill (bits, midamble, differential encoding)\n");
+    printf("  MPDU   bitwise [" BENCH_UNIT "]  register [" BENCH_UNIT "]   speedup\n");
+    for (uint16_t len : MPDU_LENGTHS) {
+        const uint16_t num_bursts = (len < TSUNBPHY_MIN_PSDU_LENGTH ? TSUNBPHY_MIN_PSDU_LENGTH : len) + TSUNBPHY_OVERHEAD;
+        if (legacyFill(num_bursts, coded) != registerFill(num_bursts, coded)) {
+            printf("  MISMATCH for MPDU length %u\n", len);
+        }
+        const double t_old = measure([&](uint32_t i) { coded[0] = (uint8_t)i; g_sink = legacyFill(num_bursts, coded); });
+        const double t_new = measure([&](uint32_t i) { coded[0] = (uint8_t)i; g_sink = registerFill(num_bursts, coded); });
+        printf("  %4u   %12.1f   %13.1f   %6.1fx\n", len, t_old, t_new, t_old / t_new);
+    }
+}
+
+typedef TsUnb::RadioBurst<2, 2> ScatterBurst_t;
+typedef SoftwareBurstScatter<uint16_t, 5> SoftwareScatter_t;
+typedef BurstScatter<uint16_t, 5> SelectedScatter_t;
+
+// Round robin, same table layout as Phy::makeScatterTable()
+template <class SCATTER>
+static void makeScatterEntries(uint16_t num_bursts, uint16_t* entries) {
+    uint8_t slots[TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD] = {0};
+    uint16_t burstIdx = 0;
+    for (uint16_t i = 0; i < num_bursts * TSUNB_RADIO_BURST_DATA_LEN; i++) {
+        entries[i] = SCATTER::makeEntry(burstIdx, ScatterBurst_t::getSubPkgRegBit(burstIdx, slots[burstIdx]++));
+        if (++burstIdx == num_bursts)
+            burstIdx = 0;
+    }
+}
+
+// Scatters the coded words with the given scatter table and commits the bursts
+template <class SCATTER>
+static uint32_t scatterFill(uint16_t num_bursts, const uint16_t* entries, const uint32_t* coded) {
+    static ScatterBurst_t storage[TSUNBPHY_MAX_NUM_BURSTS];
+    ScatterBurst_t* const bursts = resetBursts(storage, num_bursts);
+    uint32_t subPacketBits[TSUNBPHY_MAX_NUM_BURSTS] = {0};
+    {
+        const SCATTER scatter(subPacketBits);
+        for (uint16_t i = 0; i < num_bursts; i++) {
+            scatter.write24(&entries[i * 24], coded[i]);
+        }
+    }
+    for (uint16_t burstIdx = 0; burstIdx < num_bursts; burstIdx++) {
+        bursts[burstIdx].commitSubPacket(burstIdx, subPacketBits[burstIdx]);
+    }
+    return burstSum(bursts, num_bursts);
+}
+
+static void benchScatter() {
+    static uint16_t entries[(TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD) * TSUNB_RADIO_BURST_DATA_LEN];
+    static uint16_t selectedEntries[(TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD) * TSUNB_RADIO_BURST_DATA_LEN];
+    static uint32_t coded[TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD];
+    for (uint16_t i = 0; i < TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD; i++) {
+        coded[i] = (uint32_t)(i * 0x9E3779B9u) >> 8;
+    }
+
+#if defined(TSUNB_USE_INTERP)
+    printf("Scatter table write incl. commit (software vs. SIO interpolator)\n");
+    printf("  MPDU  software [" BENCH_UNIT "]  interp [" BENCH_UNIT "]   speedup\n");
+#else
+    printf("Scatter table write incl. commit (software, TSUNB_USE_INTERP not set)\n");
+    printf("  MPDU  software [" BENCH_UNIT "]  selected [" BENCH_UNIT "] speedup\n");
+#endif
+    for (uint16_t len : MPDU_LENGTHS) {
+        const uint16_t num_bursts = (len < TSUNBPHY_MIN_PSDU_LENGTH ? TSUNBPHY_MIN_PSDU_LENGTH : len) + TSUNBPHY_OVERHEAD;
+        makeScatterEntries<SoftwareScatter_t>(num_bursts, entries);
+        makeScatterEntries<SelectedScatter_t>(num_bursts, selectedEntries);
+        if (scatterFill<SoftwareScatter_t>(num_bursts, entries, coded) !=
+                scatterFill<SelectedScatter_t>(num_bursts, selectedEntries, coded)) {
+            printf("  MISMATCH for MPDU length %u\n", len);
+        }
+        const double t_sw = measure([&](uint32_t i) {
+            coded[0] = i & 0xFFFFFF;
+            g_sink = scatterFill<SoftwareScatter_t>(num_bursts, entries, coded);
+        });
+        const double t_sel = measure([&](uint32_t i) {
+            coded[0] = i & 0xFFFFFF;
+            g_sink = scatterFill<SelectedScatter_t>(num_bursts, selectedEntries, coded);
+        });
+        printf("  %4u   %12.1f   %10.1f   %6.2fx\n", len, t_sw, t_sel, t_sw / t_sel);
+    }
+}
+
+// EU1 PHY, optionally with compile-time interleaver tables for a fixed MPDU length
+template <uint16_t FIXED_MPDU_LENGTH = 0>
+using PhyEu1_t = TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst<2,2>, FIXED_MPDU_LENGTH>;
+
+template <class PHY>
+static double measureEncode(uint16_t len) {
+    PHY phy;
+    uint8_t mpdu[TSUNBPHY_MAX_PSDU_LENGTH] = {0};
+    return measure([&](uint32_t i) {
+        static typename PHY::RadioBurst_t storage[TSUNBPHY_MAX_NUM_BURSTS];
+        typename PHY::RadioBurst_t* const bursts = resetBursts(storage, phy.numRadioBursts(len));
+        mpdu[0] = (uint8_t)i;
+        g_sink = phy.encode(bursts, mpdu, len, 0) + burstSum(bursts, phy.numRadioBursts(len));
+    });
+}
+
+static void benchEncode() {
+    printf("Phy::encode() (complete packet)\n");
+    printf("  MPDU   runtime [" BENCH_UNIT "]  table [" BENCH_UNIT "]   speedup\n");
+    measureEncode<PhyEu1_t<> >(TSUNBPHY_MAX_PSDU_LENGTH);  // warm-up
+
+    const double t_10 = measureEncode<PhyEu1_t<> >(10);
+    const double t_10_table = measureEncode<PhyEu1_t<10> >(10);
+    printf("  %4u   %12.1f   %10.1f   %6.1fx\n", 10, t_10, t_10_table, t_10 / t_10_table);
+    const double t_20 = measureEncode<PhyEu1_t<> >(20);
+    const double t_20_table = measureEncode<PhyEu1_t<20> >(20);
+    printf("  %4u   %12.1f   %10.1f   %6.1fx\n", 20, t_20, t_20_table, t_20 / t_20_table);
+    const double t_64 = measureEncode<PhyEu1_t<> >(64);
+    const double t_64_table = measureEncode<PhyEu1_t<64> >(64);
+    printf("  %4u   %12.1f   %10.1f   %6.1fx\n", 64, t_64, t_64_table, t_64 / t_64_table);
+    const double t_255 = measureEncode<PhyEu1_t<> >(255);
+    const double t_255_table = measureEncode<PhyEu1_t<255> >(255);
+    printf("  %4u   %12.1f   %10.1f   %6.1fx\n", 255, t_255, t_255_table, t_255 / t_255_table);
+}
+
+static void benchConvolution() {
+    printf("Convolutional encoding (complete PSDU per packet)\n");
+    printf("  MPDU   bitwise [" BENCH_UNIT "]  table [" BENCH_UNIT "]   speedup\n");
+
+    uint8_t psdu[TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD];
+    for (size_t i = 0; i < sizeof(psdu); i++) {
+        psdu[i] = (uint8_t)(i * 73 + 41);
+    }
+
+    for (uint16_t len : MPDU_LENGTHS) {
+        const uint16_t num_bytes = len + TSUNBPHY_OVERHEAD;
+        const double t_bitwise = measure([&](uint32_t i) {
+            psdu[0] = (uint8_t)i;
+            g_sink = bitwiseConvolution(psdu, num_bytes);
+        });
+        const double t_table = measure([&](uint32_t i) {
+            psdu[0] = (uint8_t)i;
+            g_sink = tableConvolution(psdu, num_bytes);
+        });
+        printf("  %4u   %12.1f   %10.1f   %6.1fx\n", len, t_bitwise, t_table, t_bitwise / t_table);
+    }
+}
+
+int main() {
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    stdio_init_all();
+    sleep_ms(2000);  // Give the USB serial connection time to come up
+
+    // SysTick counts the processor clock, full 24 bit range
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+#endif
+
+    printf("=== TS-UNB PHY Benchmark ===\n\n");
+
+    benchCRC8();
+    printf("\n");
+    benchWhitening();
+    printf("\n");
+    benchConvolution();
+    printf("\n");
+    benchBurstFill();
+    printf("\n");
+    benchScatter();
+    printf("\n");
+    benchEncode();
+
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file test_aes.cpp
+ * @brief Host test of the AES-128 implementations of the TS-UNB-Lib
+ * 
+ * Checks the byte oriented Aes128Compact, the word oriented Aes128TTable and
+ * the host backends (AES-NI) against the FIPS-197 and SP 800-38A
+ * (ECB) known answers and against the reference Aes128Compact on pseudo
+ * random keys and blocks, including in-place encryption as used by
+ * FixedUplinkMac and the multi-block interface of the host backends.
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/Encryption/Aes128.h"
+#include "../lib/ts-unb-lib-rfm69/Encryption/Aes128TTable.h"
+#include "../lib/ts-unb-lib-rfm69/Encryption/Aes128Host.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+using namespace TsUnbLib;
+
+struct KnownAnswer {
+    const char* name;
+    uint8_t key[16];
+    uint8_t plain[16];
+    uint8_t cipher[16];
+};
+
+static const KnownAnswer KNOWN_ANSWERS[] = {
+    {"FIPS-197 Appendix B",
+     {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c},
+     {0x32, 0x43, 0xf6, 0xa8, 0x88, 0x5a, 0x30, 0x8d, 0x31, 0x31, 0x98, 0xa2, 0xe0, 0x37, 0x07, 0x34},
+     {0x39, 0x25, 0x84, 0x1d, 0x02, 0xdc, 0x09, 0xfb, 0xdc, 0x11, 0x85, 0x97, 0x19, 0x6a, 0x0b, 0x32}},
+    {"FIPS-197 Appendix C.1",
+     {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f},
+     {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff},
+     {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a}},
+    {"SP 800-38A F.1.1 block 1",
+     {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c},
+     {0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a},
+     {0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97}},
+    {"SP 800-38A F.1.1 block 2",
+     {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c},
+     {0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51},
+     {0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf}},
+    {"SP 800-38A F.1.1 block 3",
+     {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c},
+     {0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef},
+     {0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88}},
+    {"SP 800-38A F.1.1 block 4",
+     {0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c},
+     {0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10},
+     {0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f, 0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4}},
+};
+
+static void fillPseudoRandom(uint8_t* data, size_t length, uint32_t& seed) {
+    for (size_t i = 0; i < length; i++) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+template <class AES>
+static bool checkKnownAnswers(const char* name) {
+    for (const KnownAnswer& kat : KNOWN_ANSWERS) {
+        AES aes;
+        aes.init(kat.key);
+        uint8_t out[16];
+        aes.chipher(kat.plain, out);
+        if (memcmp(out, kat.cipher, 16) != 0) {
+            printf("✗ %s: %s failed\n", name, kat.name);
+            return false;
+        }
+    }
+    printf("✓ %s matches all %zu known answers\n", name, sizeof(KNOWN_ANSWERS) / sizeof(KNOWN_ANSWERS[0]));
+    return true;
+}
+
+// Encrypts numBlocks random blocks per key with chipherBlocks() and compares them with the reference
+template <class AES>
+static bool checkBlocks(const char* name) {
+    uint32_t seed = 0xCAFEF00Du;
+    for (uint32_t numBlocks = 0; numBlocks <= 40; numBlocks++) {
+        uint8_t key[16];
+        fillPseudoRandom(key, sizeof(key), seed);
+        TsUnb::Aes128Compact reference;
+        AES aes;
+        reference.init(key);
+        aes.init(key);
+
+        uint8_t blocks[40 * 16], expected[40 * 16];
+        fillPseudoRandom(blocks, numBlocks * 16, seed);
+        for (uint32_t b = 0; b < numBlocks; b++) {
+            reference.chipher(&blocks[16 * b], &expected[16 * b]);
+        }
+        aes.chipherBlocks(blocks, blocks, numBlocks);
+        if (memcmp(blocks, expected, numBlocks * 16) != 0) {
+            printf("✗ %s: mismatch for %u blocks\n", name, numBlocks);
+            return false;
+        }
+    }
+    printf("✓ %s chipherBlocks() matches the reference for 0 to 40 blocks\n", name);
+    return true;
+}
+
+// Compares single block encryption with the reference on random keys and blocks
+template <class AES>
+static bool checkRandom(const char* name) {
+    uint32_t seed = 0x12345678u;
+    const uint16_t NUM_KEYS = 100;
+    const uint16_t BLOCKS_PER_KEY = 100;
+    for (uint16_t k = 0; k < NUM_KEYS; k++) {
+        uint8_t key[16];
+        fillPseudoRandom(key, sizeof(key), seed);
+        TsUnb::Aes128Compact reference;
+        AES aes;
+        reference.init(key);
+        aes.init(key);
+        for (uint16_t b = 0; b < BLOCKS_PER_KEY; b++) {
+            uint8_t block[16], expected[16], inPlace[16];
+            fillPseudoRandom(block, sizeof(block), seed);
+            reference.chipher(block, expected);
+            memcpy(inPlace, block, 16);
+            aes.chipher(inPlace, inPlace);
+            if (memcmp(inPlace, expected, 16) != 0) {
+                printf("✗ %s: mismatch for key %u block %u\n", name, k, b);
+                return false;
+            }
+        }
+    }
+    printf("✓ %s identical for %u random keys x %u blocks\n", name, NUM_KEYS, BLOCKS_PER_KEY);
+    return true;
+}
+
+int main() {
+    printf("=== TS-UNB AES-128 Test ===\n\n");
+
+    // Test 1: Known answers
+    printf("Test 1: FIPS-197 / SP 800-38A known answers\n");
+    if (!checkKnownAnswers<TsUnb::Aes128Compact>("Aes128Compact") ||
+            !checkKnownAnswers<TsUnb::Aes128TTable>("Aes128TTable") ||
+            !checkKnownAnswers<TsUnb::Aes128Host>("Aes128Host") ||
+            !checkKnownAnswers<TsUnb::Aes128>("Aes128 (selected)")) {
+        return 1;
+    }
+#if defined(TSUNB_AES_HOST_AESNI)
+    if (TsUnb::Aes128AesNi::supported()) {
+        if (!checkKnownAnswers<TsUnb::Aes128AesNi>("Aes128AesNi")) {
+            return 1;
+        }
+    } else {
+        printf("- Aes128AesNi skipped, not supported by the CPU\n");
+    }
+#endif
+
+    printf("\n");
+
+    // Test 2: All implementations agree with the reference, also for in-place encryption
+    printf("Test 2: Random vectors vs. Aes128Compact\n");
+    if (!checkRandom<TsUnb::Aes128TTable>("Aes128TTable") ||
+            !checkRandom<TsUnb::Aes128Host>("Aes128Host")) {
+        return 1;
+    }
+#if defined(TSUNB_AES_HOST_AESNI)
+    if (TsUnb::Aes128AesNi::supported() && !checkRandom<TsUnb::Aes128AesNi>("Aes128AesNi")) {
+        return 1;
+    }
+#endif
+
+    printf("\n");
+
+    // Test 3: Multiple blocks at once, including incomplete groups of the AES-NI backend
+    printf("Test 3: chipherBlocks() vs. Aes128Compact\n");
+    if (!checkBlocks<TsUnb::Aes128TTable>("Aes128TTable") ||
+            !checkBlocks<TsUnb::Aes128Host>("Aes128Host")) {
+        return 1;
+    }
+#if defined(TSUNB_AES_HOST_AESNI)
+    if (TsUnb::Aes128AesNi::supported() && !checkBlocks<TsUnb::Aes128AesNi>("Aes128AesNi")) {
+        return 1;
+    }
+#endif
+
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
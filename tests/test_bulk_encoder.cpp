@@ -0,0 +1,226 @@
+/**
+ * @file test_bulk_encoder.cpp
+ * @brief Host test of the multi-threaded bulk encoder
+ * 
+ * Checks the work-stealing pool, the stream format, that the output does
+ * not depend on the number of threads and that the packets match a
+ * single-threaded FixedUplinkMac + Phy encoding as in SimpleNode::send().
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "bulk_encoder/BulkEncoder.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+using namespace TsUnbLib;
+using namespace TsUnbLib::Host;
+
+typedef TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst<2,2> > PhyEu1_t;
+
+typedef std::pair<uint64_t, uint32_t> PacketKey;    // EUI-64, packet counter
+
+static uint32_t readLe(const uint8_t* p, size_t len) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < len; i++) {
+        value |= (uint32_t)p[i] << (8 * i);
+    }
+    return value;
+}
+
+// Splits the stream into packet records, returns false on a format error
+static bool parseStream(const std::vector<uint8_t>& stream, std::map<PacketKey, std::vector<uint8_t> >& packets) {
+    if (stream.size() < BULK_STREAM_HEADER_LEN || stream[0] != 'T' || stream[1] != 'S' ||
+            stream[2] != 'U' || stream[3] != 'B' || stream[4] != BULK_STREAM_VERSION) {
+        return false;
+    }
+    const size_t burstLen = stream[5];
+    size_t pos = BULK_STREAM_HEADER_LEN;
+    while (pos < stream.size()) {
+        if (pos + BULK_PACKET_HEADER_LEN > stream.size()) {
+            return false;
+        }
+        uint64_t eui = 0;
+        for (size_t i = 0; i < 8; i++) {
+            eui = (eui << 8) | stream[pos + i];
+        }
+        const uint32_t counter = readLe(&stream[pos + 8], 4);
+        const uint16_t numBursts = readLe(&stream[pos + 17], 2);
+        const size_t len = BULK_PACKET_HEADER_LEN + numBursts * (4 + burstLen);
+        if (pos + len > stream.size()) {
+            return false;
+        }
+        if (!packets.emplace(PacketKey(eui, counter), std::vector<uint8_t>(&stream[pos], &stream[pos] + len)).second) {
+            return false;   // Duplicate packet
+        }
+        pos += len;
+    }
+    return true;
+}
+
+static std::vector<uint8_t> encodeStream(BulkRegion region, const BulkEncodeConfig& config, unsigned threads) {
+    std::vector<uint8_t> stream;
+    WorkStealingPool pool(threads);
+    bulkEncodeRegion(region, config, [&](const uint8_t* data, size_t len) {
+        stream.insert(stream.end(), data, data + len);
+    }, pool);
+    return stream;
+}
+
+int main() {
+    printf("=== TS-UNB Bulk Encoder Test ===\n\n");
+
+    // Test 1: Every task runs exactly once, also with more workers than cores
+    printf("Test 1: Work-stealing pool\n");
+    {
+        WorkStealingPool pool(8);
+        for (uint64_t numTasks : {0ull, 1ull, 7ull, 1000ull}) {
+            std::vector<std::atomic<unsigned> > runs(numTasks);
+            for (auto& r : runs) {
+                r = 0;
+            }
+            pool.run(numTasks, [&](unsigned worker, uint64_t task) {
+                if (worker < pool.size()) {
+                    runs[task]++;
+                }
+            });
+            for (uint64_t i = 0; i < numTasks; i++) {
+                if (runs[i] != 1) {
+                    printf("✗ Task %llu of %llu ran %u times\n", (unsigned long long)i,
+                           (unsigned long long)numTasks, (unsigned)runs[i]);
+                    return 1;
+                }
+            }
+        }
+
+        bool caught = false;
+        try {
+            pool.run(100, [](unsigned, uint64_t task) {
+                if (task == 42) {
+                    throw std::runtime_error("task failed");
+                }
+            });
+        } catch (const std::runtime_error&) {
+            caught = true;
+        }
+        if (!caught) {
+            printf("✗ Exception of a task was not passed to run()\n");
+            return 1;
+        }
+        printf("✓ All tasks run once, exceptions are passed to the caller\n");
+    }
+
+    printf("\n");
+
+    BulkEncodeConfig config;
+    config.numNodes = 37;
+    config.packetsPerNode = 23;
+    config.firstPacketCounter = 1000;
+    config.payloadLength = 17;
+    config.packetsPerTask = 5;
+    for (uint8_t i = 0; i < 16; i++) {
+        config.networkKey[i] = i * 17 + 3;
+    }
+
+    // Test 2: Same packets for any number of threads
+    printf("Test 2: Output independent of the number of threads\n");
+    std::map<PacketKey, std::vector<uint8_t> > packets;
+    {
+        const std::vector<uint8_t> single = encodeStream(BULK_REGION_EU1, config, 1);
+        if (!parseStream(single, packets) || packets.size() != config.numNodes * config.packetsPerNode) {
+            printf("✗ Stream format error or wrong number of packets (%zu)\n", packets.size());
+            return 1;
+        }
+        for (unsigned threads : {2u, 4u, 7u}) {
+            std::map<PacketKey, std::vector<uint8_t> > multi;
+            if (!parseStream(encodeStream(BULK_REGION_EU1, config, threads), multi) || multi != packets) {
+                printf("✗ Output with %u threads differs\n", threads);
+                return 1;
+            }
+        }
+        printf("✓ %zu packets identical for 1, 2, 4 and 7 threads\n", packets.size());
+    }
+
+    printf("\n");
+
+    // Test 3: Packets match a direct encoding with FixedUplinkMac and Phy
+    printf("Test 3: Packets match FixedUplinkMac + Phy\n");
+    {
+        for (uint32_t nodeIdx : {0u, 13u, 36u}) {
+            uint8_t eui64[8];
+            bulkNodeEui64(config, nodeIdx, eui64);
+            TsUnb::FixedUplinkMac mac;
+            const uint8_t* k = config.networkKey;
+            mac.setNetworkKey(k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7],
+                              k[8], k[9], k[10], k[11], k[12], k[13], k[14], k[15]);
+            mac.setAddress(eui64[0], eui64[1], eui64[2], eui64[3], eui64[4], eui64[5], eui64[6], eui64[7]);
+            mac.extPkgCnt = config.firstPacketCounter;
+
+            uint64_t eui = 0;
+            for (uint8_t b : eui64) {
+                eui = (eui << 8) | b;
+            }
+
+            for (uint32_t i = 0; i < config.packetsPerNode; i++) {
+                const uint32_t counter = mac.extPkgCnt;
+                uint8_t payload[17];
+                uint8_t mpdu[TSUNBPHY_MAX_PSDU_LENGTH];
+                bulkPayload(nodeIdx, counter, payload, sizeof(payload));
+                const uint16_t mpduLength = mac.encode(mpdu, payload, sizeof(payload));
+
+                PhyEu1_t phy;
+                PhyEu1_t::RadioBurst_t bursts[TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD];
+                const uint8_t pattern = mac.getTsmaPattern();
+                const uint32_t f0 = phy.encode(bursts, mpdu, mpduLength, pattern);
+                const uint16_t numBursts = phy.numRadioBursts(mpduLength);
+
+                const auto it = packets.find(PacketKey(eui, counter));
+                bool ok = it != packets.end();
+                if (ok) {
+                    const std::vector<uint8_t>& r = it->second;
+                    ok = r[12] == pattern && readLe(&r[13], 4) == f0 && readLe(&r[17], 2) == numBursts;
+                    for (uint16_t b = 0; ok && b < numBursts; b++) {
+                        const uint8_t* rb = &r[BULK_PACKET_HEADER_LEN + b * (4 + PhyEu1_t::RadioBurst_t::BURST_LENGTH_BYTES)];
+                        ok = readLe(rb, 2) == bursts[b].getCarrierOffset() && readLe(rb + 2, 2) == bursts[b].get_T_RB();
+                        for (uint16_t j = 0; ok && j < PhyEu1_t::RadioBurst_t::BURST_LENGTH_BYTES; j++) {
+                            ok = rb[4 + j] == bursts[b].getBurst()[j];
+                        }
+                    }
+                }
+                if (!ok) {
+                    printf("✗ Node %u packet counter %u differs\n", nodeIdx, counter);
+                    return 1;
+                }
+            }
+        }
+        printf("✓ Bursts, timing and f_0 match the single packet encoder\n");
+    }
+
+    printf("\n");
+
+    // Test 4: US0 adds the sync burst in front of the data bursts
+    printf("Test 4: Sync burst for US0\n");
+    {
+        config.numNodes = 2;
+        std::map<PacketKey, std::vector<uint8_t> > us0;
+        if (!parseStream(encodeStream(BULK_REGION_US0, config, 2), us0) || us0.empty()) {
+            printf("✗ Stream format error\n");
+            return 1;
+        }
+        const uint16_t numBursts = readLe(&us0.begin()->second[17], 2);
+        if (numBursts != PhyEu1_t().numRadioBursts(TsUnb::FixedUplinkMac().MPDU_Length(config.payloadLength)) + 1) {
+            printf("✗ %u bursts, sync burst missing\n", numBursts);
+            return 1;
+        }
+        printf("✓ %u bursts including the sync burst\n", numBursts);
+    }
+
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
@@ -0,0 +1,161 @@
+/**
+ * @file test_cmac.cpp
+ * @brief Host test of the streaming AES-CMAC of the TS-UNB-Lib
+ * 
+ * Checks AesCmac against the AES-128 examples of NIST SP 800-38B (D.1),
+ * independent of how the message is split into update() fragments, and
+ * that updateEncrypt() gives the same cipher text and tag as a separate
+ * CTR encryption followed by update().
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/Encryption/AesCmac.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+using namespace TsUnbLib;
+
+static const uint8_t KEY[16] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c};
+
+static const uint8_t MESSAGE[64] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10};
+
+struct CmacExample {
+    uint16_t length;
+    uint8_t tag[16];
+};
+
+// NIST SP 800-38B, D.1 AES-128, examples 1 to 4
+static const CmacExample EXAMPLES[] = {
+    {0, {0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28, 0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46}},
+    {16, {0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44, 0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c}},
+    {40, {0xdf, 0xa6, 0x67, 0x47, 0xde, 0x9a, 0xe6, 0x30, 0x30, 0xca, 0x32, 0x61, 0x14, 0x97, 0xc8, 0x27}},
+    {64, {0x51, 0xf0, 0xbe, 0xbf, 0x7e, 0x3b, 0x9d, 0x92, 0xfc, 0x49, 0x74, 0x17, 0x79, 0x36, 0x3c, 0xfe}},
+};
+
+static uint32_t g_lfsr = 0xACE1u;
+
+static uint8_t nextRandom() {
+    g_lfsr ^= g_lfsr << 13;
+    g_lfsr ^= g_lfsr >> 17;
+    g_lfsr ^= g_lfsr << 5;
+    return (uint8_t)g_lfsr;
+}
+
+int main() {
+    printf("=== TS-UNB AES-CMAC Test ===\n\n");
+
+    TsUnb::AesCmac cmac;
+    cmac.setKey(KEY);
+
+    // Test 1: Complete message in one update()
+    printf("Test 1: NIST SP 800-38B examples\n");
+    for (const CmacExample& e : EXAMPLES) {
+        uint8_t tag[16];
+        cmac.init();
+        cmac.update(MESSAGE, e.length);
+        cmac.final(tag);
+        if (memcmp(tag, e.tag, 16) != 0) {
+            printf("✗ Tag of the %u byte message differs\n", e.length);
+            return 1;
+        }
+    }
+    printf("✓ Tags of the 0, 16, 40 and 64 byte messages match\n");
+
+    printf("\n");
+
+    // Test 2: Message split into fragments at every position and into random fragments
+    printf("Test 2: Fragmented messages\n");
+    for (const CmacExample& e : EXAMPLES) {
+        for (uint16_t split = 0; split <= e.length; split++) {
+            uint8_t tag[16];
+            cmac.init();
+            cmac.update(MESSAGE, split);
+            cmac.update(&MESSAGE[split], 0);
+            cmac.update(&MESSAGE[split], e.length - split);
+            cmac.final(tag);
+            if (memcmp(tag, e.tag, 16) != 0) {
+                printf("✗ %u byte message split at %u\n", e.length, split);
+                return 1;
+            }
+        }
+        for (int trial = 0; trial < 100; trial++) {
+            uint8_t tag[16];
+            cmac.init();
+            uint16_t pos = 0;
+            while (pos < e.length) {
+                uint16_t n = nextRandom() % 20;
+                if (n > e.length - pos) {
+                    n = e.length - pos;
+                }
+                cmac.update(&MESSAGE[pos], n);
+                pos += n;
+            }
+            cmac.final(tag);
+            if (memcmp(tag, e.tag, 16) != 0) {
+                printf("✗ %u byte message in random fragments\n", e.length);
+                return 1;
+            }
+        }
+    }
+    printf("✓ Tags are independent of the fragmentation\n");
+
+    // The chaining value of init() continues a CMAC after complete blocks
+    {
+        uint8_t chaining[16], tag[16];
+        cmac.aes().chipher(MESSAGE, chaining);
+        cmac.init(chaining);
+        cmac.update(&MESSAGE[16], 48);
+        cmac.final(tag);
+        if (memcmp(tag, EXAMPLES[3].tag, 16) != 0) {
+            printf("✗ init() with chaining value\n");
+            return 1;
+        }
+    }
+    printf("✓ init() with the chaining value of the first block continues the CMAC\n");
+
+    printf("\n");
+
+    // Test 3: Fused CTR encryption and CMAC
+    printf("Test 3: updateEncrypt()\n");
+    for (int trial = 0; trial < 200; trial++) {
+        uint8_t plain[100], keystream[100], separate[100], fused[100];
+        const uint16_t header = nextRandom() % 16;
+        const uint16_t length = header + nextRandom() % 84;
+        for (uint16_t i = 0; i < length; i++) {
+            plain[i] = nextRandom();
+            keystream[i] = nextRandom();
+            separate[i] = (i < header) ? plain[i] : (uint8_t)(plain[i] ^ keystream[i]);
+            fused[i] = plain[i];
+        }
+
+        uint8_t expected[16], tag[16];
+        cmac.init();
+        cmac.update(separate, length);
+        cmac.final(expected);
+
+        cmac.init();
+        cmac.update(fused, header);
+        for (uint16_t pos = header; pos < length; pos += 16) {
+            const uint16_t n = (length - pos < 16) ? length - pos : 16;
+            cmac.updateEncrypt(&fused[pos], n, &keystream[pos]);
+        }
+        cmac.final(tag);
+
+        if (memcmp(fused, separate, length) != 0 || memcmp(tag, expected, 16) != 0) {
+            printf("✗ Fused encryption differs for %u bytes after a %u byte header\n", length, header);
+            return 1;
+        }
+    }
+    printf("✓ Cipher text and tag match the separate encryption and CMAC\n");
+
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file test_frequency_images.cpp
+ * @brief Test of the precomputed frequency register images of the radio bursts
+ *
+ * Sends packets with host versions of all node configurations of
+ * RPPicoTsUnbTemplates.h and compares the frequencies written to the FRF
+ * registers of the emulated RFM69 with the previous computation in
+ * Rfm69hw::transmit(), i.e. f_0 plus the carrier offset of each burst split
+ * into three bytes, most significant byte first.
+ *
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/src/HostTsUnb.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+using namespace TsUnbLib;
+
+// Host platform which records the frequency register writes
+class RecordingTsUnb : public Host::HostTsUnb<48> {
+public:
+    void spiSend(const uint8_t* const dataOut, const uint8_t numBytes) {
+        Host::HostTsUnb<48>::spiSend(dataOut, numBytes);
+        if (numBytes == 4 && dataOut[0] == RFM69_WRITE_FRF) {
+            frequencies.push_back((uint32_t) dataOut[1] << 16 | (uint32_t) dataOut[2] << 8 | dataOut[3]);
+        }
+    }
+    std::vector<uint32_t> frequencies;
+};
+
+// f_0 returned by the last PHY encoding, the transmitter only gets the images of the bursts
+static uint32_t encodedF0 = 0;
+
+// PHY which records f_0 for the expected frequencies
+template <uint32_t CHAN_A, uint32_t CHAN_B, uint32_t B_C, uint32_t B_C0, TsUnb::TsUnbUPGMode UPG>
+class RecordingPhy : public TsUnb::Phy<CHAN_A, CHAN_B, B_C, B_C0, UPG, 0, 3, TsUnb::RadioBurst<2,2> > {
+public:
+    uint32_t encode(TsUnb::RadioBurst<2,2>* const RadioBursts, const uint8_t* const MPDU,
+                    const uint16_t MPDU_Length, const uint8_t TSMAPattern = 0) {
+        encodedF0 = TsUnb::Phy<CHAN_A, CHAN_B, B_C, B_C0, UPG, 0, 3, TsUnb::RadioBurst<2,2> >::encode(
+                RadioBursts, MPDU, MPDU_Length, TSMAPattern);
+        return encodedF0;
+    }
+};
+
+// Transmitter which computes the expected frequencies from the bursts as Rfm69hw did before
+template <bool RFM69HW>
+class CheckedRfm69hw : public Trx::Rfm69hw<RecordingTsUnb, RFM69HW, 10, TsUnb::RadioBurst<2,2> > {
+public:
+    int16_t transmit(const TsUnb::RadioBurst<2,2>* const Bursts, const uint16_t numTxBursts) {
+        expected.clear();
+        for (uint16_t burstIdx = 0; burstIdx < numTxBursts; ++burstIdx) {
+            if (Bursts[burstIdx].getBurstLength() == 0)
+                continue;
+            const uint32_t modFreq = encodedF0 + (uint32_t) Bursts[burstIdx].getCarrierOffset();
+            expected.push_back(modFreq & 0xFFFFFF);
+        }
+        ++packets;
+        this->Cpu.frequencies.clear();
+        return Trx::Rfm69hw<RecordingTsUnb, RFM69HW, 10, TsUnb::RadioBurst<2,2> >::transmit(Bursts, numTxBursts);
+    }
+    std::vector<uint32_t> expected;
+    uint32_t packets = 0;
+};
+
+// Host version of a node of RPPicoTsUnbTemplates.h
+template <uint32_t CHAN_A, uint32_t CHAN_B, uint32_t B_C, uint32_t B_C0, TsUnb::TsUnbUPGMode UPG,
+          bool RFM69HW, bool SYNC_BURST>
+struct Region {
+    typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+        RecordingPhy<CHAN_A, CHAN_B, B_C, B_C0, UPG>,
+        CheckedRfm69hw<RFM69HW>, SYNC_BURST> Node_t;
+};
+
+// Sends packets of several lengths, also with priority, and compares the frequencies of all bursts
+template <class REGION>
+static bool checkRegion(const char* name) {
+    typename REGION::Node_t node;
+    node.Mac.setNetworkKey(0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                           0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c);
+    node.Mac.setEui64(0x70, 0xB3, 0xD5, 0x67, 0x70, 0xFF, 0x00, 0x01);
+    node.Mac.setShortAddress(0x00, 0x01);
+    node.init();
+
+    const uint16_t payloadLengths[] = {1, 10, 47, 100, TSUNBPHY_MAX_PSDU_LENGTH - MAC_OVERHEAD_SHORT_ADDR};
+    uint8_t payload[TSUNBPHY_MAX_PSDU_LENGTH];
+    uint32_t bursts = 0;
+    for (const uint16_t payloadLength : payloadLengths) {
+        // The MAC changes the TSMA pattern with every packet, the priority packets use pattern 6
+        for (uint16_t packet = 0; packet < 8; ++packet) {
+            for (uint16_t i = 0; i < payloadLength; i++) {
+                payload[i] = (uint8_t)(i * 13 + packet);
+            }
+            const bool priority = packet == 7;
+            node.send(payload, payloadLength, 0, priority);
+            if (node.Tx.Cpu.frequencies != node.Tx.expected || node.Tx.expected.empty()) {
+                printf("✗ %s: payload %u, packet %u: %zu frequencies written, %zu expected\n", name,
+                       payloadLength, packet, node.Tx.Cpu.frequencies.size(), node.Tx.expected.size());
+                for (size_t i = 0; i < node.Tx.expected.size() && i < node.Tx.Cpu.frequencies.size(); ++i) {
+                    if (node.Tx.Cpu.frequencies[i] != node.Tx.expected[i]) {
+                        printf("  burst %zu: 0x%06X instead of 0x%06X\n", i,
+                               node.Tx.Cpu.frequencies[i], node.Tx.expected[i]);
+                        break;
+                    }
+                }
+                return false;
+            }
+            bursts += node.Tx.expected.size();
+        }
+    }
+    printf("✓ %-24s %u packets, %u burst frequencies\n", name, node.Tx.packets, bursts);
+    return true;
+}
+
+int main() {
+    printf("=== TS-UNB Frequency Register Image Test ===\n\n");
+
+    // Test 1: RFM69W configurations
+    printf("Test 1: RFM69W configurations\n");
+    if (!checkRegion<Region<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG1, false, false> >("EU0") ||
+        !checkRegion<Region<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, false, false> >("EU1") ||
+        !checkRegion<Region<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG1, false, false> >("EU2") ||
+        !checkRegion<Region<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG1, false, true> >("US0") ||
+        !checkRegion<Region<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG3, false, false> >("EU0 Low Latency") ||
+        !checkRegion<Region<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG3, false, false> >("EU1 Low Latency") ||
+        !checkRegion<Region<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG3, false, false> >("EU2 Low Latency") ||
+        !checkRegion<Region<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG3, false, true> >("US0 Low Latency")) {
+        return 1;
+    }
+
+    printf("\n");
+
+    // Test 2: RFM69HW configurations
+    printf("Test 2: RFM69HW configurations\n");
+    if (!checkRegion<Region<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG1, true, false> >("EU0") ||
+        !checkRegion<Region<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, true, false> >("EU1") ||
+        !checkRegion<Region<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG1, true, false> >("EU2") ||
+        !checkRegion<Region<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG1, true, true> >("US0") ||
+        !checkRegion<Region<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG3, true, false> >("EU0 Low Latency") ||
+        !checkRegion<Region<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG3, true, false> >("EU1 Low Latency") ||
+        !checkRegion<Region<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG3, true, false> >("EU2 Low Latency") ||
+        !checkRegion<Region<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG3, true, true> >("US0 Low Latency")) {
+        return 1;
+    }
+
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
@@ -0,0 +1,245 @@
+/**
+ * @file test_mac.cpp
+ * @brief Host test of the TS-UNB fixed uplink MAC
+ * 
+ * Checks the FixedUplinkMac::encode() output against golden vectors, which
+ * were recorded with the original implementation of the TS-UNB-Lib (key
+ * expansion and CMAC subkeys per packet), that setNetworkKey()
+ * invalidates the cached key schedule, and that the blocks precomputed by
+ * prepareNextFrame() give identical MPDUs or are discarded when stale.
+ * The in-place encoding (payload already in the MPDU buffer) must give the
+ * same MPDUs and, through SimpleNode::sendInPlace(), the same transmission.
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/src/HostTsUnb.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+
+using namespace TsUnbLib;
+
+// Golden vectors: FNV-1a hash over the MPDU, consecutive packets of one MAC instance.
+// The MPF field is present for odd payload lengths.
+struct GoldenVector {
+    uint8_t long_address;
+    uint16_t payload_length;
+    uint16_t mpdu_length;
+    uint32_t hash;
+};
+
+static const GoldenVector GOLDEN_VECTORS[] = {
+    {0,   0,  10, 0xB9F0D1D4u},
+    {0,   1,  12, 0x2D355386u},
+    {0,   5,  16, 0xDD1F20C8u},
+    {0,   6,  16, 0x15D7E0AAu},
+    {0,  15,  26, 0x4DB88294u},
+    {0,  16,  26, 0xE3D26A41u},
+    {0,  17,  28, 0xD62DB3C8u},
+    {0,  22,  32, 0x8B780831u},
+    {0,  32,  42, 0x1B5E781Fu},
+    {0, 100, 110, 0x00CA1567u},
+    {0, 244, 254, 0xCFCCA68Au},
+    {1,   0,  16, 0xC479E00Au},
+    {1,   1,  18, 0x3CAC5E48u},
+    {1,   5,  22, 0xB476B66Fu},
+    {1,   6,  22, 0xCB77E8D2u},
+    {1,  15,  32, 0xE5AE9835u},
+    {1,  16,  32, 0x387CF162u},
+    {1,  17,  34, 0xD116AD99u},
+    {1,  22,  38, 0x82657120u},
+    {1,  32,  48, 0x38D6AD69u},
+    {1, 100, 116, 0x3DFB5642u},
+};
+
+// Hash of the 10 byte payload 1..10 with the key 1..16, short address, packet counter 0
+static const uint32_t KEY2_HASH = 0x173A1ECBu;
+
+static uint32_t fnv1a(const uint8_t* data, uint16_t length) {
+    uint32_t hash = 2166136261u;
+    for (uint16_t i = 0; i < length; i++) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void setupMac(TsUnb::FixedUplinkMac& mac, bool longAddress) {
+    mac.setNetworkKey(0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+                      0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C);
+    mac.setAddress(0x70, 0xB3, 0xD5, 0x67, 0x70, 0x00, 0x12, 0x34);
+    mac.setAddressMode(longAddress ? TsUnb::TsUnb_Long : TsUnb::TsUnb_Short);
+    mac.extPkgCnt = 0x00ABCDEF;
+}
+
+static uint32_t encodePacket0(TsUnb::FixedUplinkMac& mac) {
+    mac.setAddressMode(TsUnb::TsUnb_Short);
+    mac.extPkgCnt = 0;
+    const uint8_t payload[10] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    uint8_t mpdu[256];
+    const uint16_t length = mac.encode(mpdu, payload, sizeof(payload));
+    return fnv1a(mpdu, length);
+}
+
+static uint32_t encodeKey2(TsUnb::FixedUplinkMac& mac) {
+    mac.setNetworkKey(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+    return encodePacket0(mac);
+}
+
+// Encodes the golden vectors, optionally after prepareNextFrame() or in place; returns false on a mismatch
+static bool checkGoldenVectors(bool prepare, bool inPlace = false) {
+    TsUnb::FixedUplinkMac macs[2];
+    setupMac(macs[0], false);
+    setupMac(macs[1], true);
+    for (const GoldenVector& v : GOLDEN_VECTORS) {
+        TsUnb::FixedUplinkMac& mac = macs[v.long_address];
+        const bool mpf = v.payload_length % 2;
+        uint8_t payload[255];
+        uint8_t frame[TsUnb::FixedUplinkMac::HEADROOM + 255 + TsUnb::FixedUplinkMac::TAG_LENGTH];
+        uint8_t* mpdu = inPlace ? &frame[TsUnb::FixedUplinkMac::HEADROOM - mac.headerLength(mpf)] : frame;
+        uint8_t* dst = inPlace ? &frame[TsUnb::FixedUplinkMac::HEADROOM] : payload;
+        for (uint16_t i = 0; i < v.payload_length; i++) {
+            dst[i] = (uint8_t)(i * 31 + v.payload_length);
+        }
+        if (prepare) {
+            mac.prepareNextFrame();
+        }
+        const uint16_t length = inPlace ? mac.encodeInPlace(mpdu, v.payload_length, mpf, 0x5A)
+                                        : mac.encode(mpdu, payload, v.payload_length, mpf, 0x5A);
+        const uint32_t hash = fnv1a(mpdu, length);
+        if (length != v.mpdu_length || length != mac.MPDU_Length(v.payload_length, mpf) || hash != v.hash) {
+            printf("✗ %s address, payload %u: got %u bytes %08X, expected %u bytes %08X\n",
+                   v.long_address ? "long" : "short", v.payload_length, length, hash, v.mpdu_length, v.hash);
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    printf("=== TS-UNB MAC Test ===\n\n");
+
+    // Test 1: Output of consecutive packets with the cached key schedule
+    printf("Test 1: FixedUplinkMac::encode() golden vectors\n");
+    if (!checkGoldenVectors(false)) {
+        return 1;
+    }
+    printf("✓ MPDUs are identical to the original implementation\n");
+
+    printf("\n");
+
+    // Test 2: A new network key replaces the cached key schedule and CMAC subkeys
+    printf("Test 2: Key change\n");
+    {
+        TsUnb::FixedUplinkMac used;
+        setupMac(used, false);
+        const uint8_t payload[4] = {1, 2, 3, 4};
+        uint8_t mpdu[256];
+        used.encode(mpdu, payload, sizeof(payload));
+        TsUnb::FixedUplinkMac fresh;
+        fresh.setAddress(0x70, 0xB3, 0xD5, 0x67, 0x70, 0x00, 0x12, 0x34);
+        if (encodeKey2(used) != KEY2_HASH || encodeKey2(fresh) != KEY2_HASH) {
+            printf("✗ MPDU after setNetworkKey() uses the old key\n");
+            return 1;
+        }
+        printf("✓ setNetworkKey() invalidates the cached key schedule\n");
+    }
+
+    printf("\n");
+
+    // Test 3: Keystream and CMAC IV precomputed before the payload is known
+    printf("Test 3: prepareNextFrame()\n");
+    if (!checkGoldenVectors(true)) {
+        return 1;
+    }
+    printf("✓ MPDUs with prepared blocks are identical, also beyond %u prepared blocks\n",
+           (unsigned)TSUNB_MAC_PREPARED_BLOCKS);
+    {
+        // Blocks prepared for another key, counter or EUI-64 must not be used
+        TsUnb::FixedUplinkMac mac;
+        mac.setAddress(0x70, 0xB3, 0xD5, 0x67, 0x70, 0x00, 0x12, 0x34);
+        mac.prepareNextFrame();
+        if (encodeKey2(mac) != KEY2_HASH) {
+            printf("✗ Prepared blocks of the old key are used\n");
+            return 1;
+        }
+
+        mac.extPkgCnt = 5;
+        mac.prepareNextFrame();
+        if (encodePacket0(mac) != KEY2_HASH) {
+            printf("✗ Prepared blocks of another packet counter are used\n");
+            return 1;
+        }
+
+        mac.eui64[0] = 0;
+        mac.extPkgCnt = 0;
+        mac.prepareNextFrame();
+        mac.eui64[0] = 0x70;
+        if (encodePacket0(mac) != KEY2_HASH) {
+            printf("✗ Prepared blocks of another EUI-64 are used\n");
+            return 1;
+        }
+        printf("✓ Stale prepared blocks are discarded\n");
+    }
+
+    printf("\n");
+
+    // Test 4: Payload assembled behind the MAC headroom, encrypted and tagged in place
+    printf("Test 4: In-place encoding\n");
+    if (!checkGoldenVectors(false, true) || !checkGoldenVectors(true, true)) {
+        return 1;
+    }
+    printf("✓ encodeInPlace() MPDUs are identical to encode()\n");
+    {
+        Host::TsUnb_EU1_Host_t copied, inPlace;
+        setupMac(copied.Mac, false);
+        setupMac(inPlace.Mac, false);
+        copied.init();
+        inPlace.init();
+        for (uint16_t length = 1; length <= 64; length += 9) {
+            uint8_t payload[64];
+            uint8_t frame[TsUnb::FixedUplinkMac::HEADROOM + 64 + TsUnb::FixedUplinkMac::TAG_LENGTH];
+            for (uint16_t i = 0; i < length; i++) {
+                payload[i] = frame[TsUnb::FixedUplinkMac::HEADROOM + i] = (uint8_t)(i ^ length);
+            }
+            const uint8_t mpf = (length & 2) ? 0x5A : 0;
+            copied.send(payload, length, mpf);
+            inPlace.sendInPlace(frame, length, mpf);
+            if (memcmp(copied.Tx.Cpu.registers, inPlace.Tx.Cpu.registers, sizeof(copied.Tx.Cpu.registers)) != 0 ||
+                copied.Tx.Cpu.elapsedSymbols != inPlace.Tx.Cpu.elapsedSymbols ||
+                copied.Tx.Cpu.spiBytes != inPlace.Tx.Cpu.spiBytes) {
+                printf("✗ SimpleNode::sendInPlace() differs from send() for %u bytes\n", length);
+                return 1;
+            }
+        }
+        printf("✓ SimpleNode::sendInPlace() transmits the same as send()\n");
+
+        // Too long payloads are rejected before the encryption, 502 bytes wrapped to a valid length before
+        static uint8_t frame[TsUnb::FixedUplinkMac::HEADROOM + 512 + TsUnb::FixedUplinkMac::TAG_LENGTH];
+        const uint32_t spiBytes = inPlace.Tx.Cpu.spiBytes;
+        const uint16_t tooLong[] = {TSUNBPHY_MAX_PSDU_LENGTH - MAC_OVERHEAD_SHORT_ADDR + 1, 502};
+        for (const uint16_t length : tooLong) {
+            if (inPlace.sendInPlace(frame, length) >= 0 || inPlace.send(frame, length) >= 0 ||
+                inPlace.Tx.Cpu.spiBytes != spiBytes) {
+                printf("✗ Payload of %u bytes is not rejected\n", length);
+                return 1;
+            }
+        }
+        // The packet counter is unchanged, the next MPDU is the same as without the rejected payloads
+        const uint8_t payload[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+        uint8_t expected[MAC_OVERHEAD_SHORT_ADDR + sizeof(payload)], mpdu[sizeof(expected)];
+        copied.Mac.encode(expected, payload, sizeof(payload));
+        inPlace.Mac.encode(mpdu, payload, sizeof(payload));
+        if (memcmp(expected, mpdu, sizeof(expected)) != 0) {
+            printf("✗ Rejected payload changed the next packet\n");
+            return 1;
+        }
+        printf("✓ Payloads longer than %u bytes are rejected without side effects\n",
+               TSUNBPHY_MAX_PSDU_LENGTH - MAC_OVERHEAD_SHORT_ADDR);
+    }
+
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
@@ -22,7 +22,8 @@ int main() {
     printf("=== MIOTY Payload Configuration Test ===\n\n");
     
     // Test payload builder
-    PayloadConfig::PayloadBuilder builder;
+    uint8_t buffer[PayloadConfig::MAX_PAYLOAD_SIZE];
+    PayloadConfig::PayloadBuilder builder(buffer, sizeof(buffer));
     
     // Test 1: Basic temperature payload
     printf("Test 1: Basic temperature payload\n");
@@ -103,6 +104,33 @@ int main() {
         print_hex(test_payload, 8); // Just show header
     }
     
+    printf("\n");
+    
+    // Test 4: Payload is assembled in the buffer of the caller (e.g. the MPDU payload region)
+    printf("Test 4: External payload buffer\n");
+    builder.reset();
+    builder.addSensorData(PayloadConfig::SensorType::INTERNAL_TEMPERATURE, 23.45f);
+    payload_data = builder.getPayload(20, &payload_length);
+    uint8_t frame[4 + PayloadConfig::PayloadHeader::SIZE + 2 + 4];
+    memset(frame, 0xEE, sizeof(frame));
+    PayloadConfig::PayloadBuilder in_place(&frame[4], PayloadConfig::PayloadHeader::SIZE + 2);
+    in_place.addSensorData(PayloadConfig::SensorType::INTERNAL_TEMPERATURE, 23.45f);
+    size_t in_place_length;
+    const uint8_t* in_place_payload = in_place.getPayload(20, &in_place_length);
+    if (in_place_payload != &frame[4] || in_place_length != payload_length ||
+        memcmp(in_place_payload, payload_data, payload_length) != 0 || frame[3] != 0xEE ||
+        frame[4 + payload_length] != 0xEE) {
+        printf("✗ Payload not assembled in place\n");
+        return 1;
+    }
+    printf("✓ Payload assembled in the external buffer without touching the headroom\n");
+    
+    if (in_place.addSensorData(PayloadConfig::SensorType::INTERNAL_TEMPERATURE, 1.0f)) {
+        printf("✗ Buffer capacity exceeded\n");
+        return 1;
+    }
+    printf("✓ Buffer capacity is respected\n");
+    
     printf("\n=== All tests completed successfully! ===\n");
     
     return 0;
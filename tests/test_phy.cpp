@@ -0,0 +1,217 @@
+/**
+ * @file test_phy.cpp
+ * @brief Host test of the TS-UNB PHY encoder
+ * 
+ * Checks the PHY building blocks against bit serial reference implementations
+ * and the complete Phy::encode() output against golden vectors, which were
+ * recorded with the original bit serial implementation of the TS-UNB-Lib.
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/TsUnb/RadioBurst.h"
+#include "../lib/ts-unb-lib-rfm69/TsUnb/Phy.h"
+#include <cstdio>
+#include <cstdint>
+
+using namespace TsUnbLib;
+
+// PHY configurations of the EU1 (UPG1), US0 with UPG2 and EU1 low latency (UPG3) nodes
+typedef TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst<2,2> > PhyUpg1_t;
+typedef TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG2, 0, 3, TsUnb::RadioBurst<2,2> > PhyUpg2_t;
+typedef TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG3, 0, 3, TsUnb::RadioBurst<2,2> > PhyUpg3_t;
+
+// EU1 PHY with compile-time interleaver tables for the given MPDU length
+template <uint16_t FIXED_MPDU_LENGTH>
+using PhyUpg1Fixed_t = TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst<2,2>, FIXED_MPDU_LENGTH>;
+
+// Golden vectors: FNV-1a hash over f_0 and all bursts (data, carrier offset, T_RB)
+struct GoldenVector {
+    uint16_t mpdu_length;
+    uint32_t hash_upg1;
+    uint32_t hash_upg2;
+    uint32_t hash_upg3;
+};
+
+static const GoldenVector GOLDEN_VECTORS[] = {
+    {  0, 0xD10BEDBBu, 0x2B7E37D3u, 0x085611DCu},
+    {  1, 0x7205CE0Eu, 0x3C7B638Fu, 0xACF6DF3Du},
+    { 10, 0x0198D485u, 0x0BEDA7BEu, 0x40497057u},
+    { 13, 0x2A3215FBu, 0x58627443u, 0x34BE3EE3u},
+    { 19, 0xF12E2493u, 0x423299E3u, 0x6FFE406Du},
+    { 20, 0x1F33A2DEu, 0xE3522F0Au, 0x507F174Au},
+    { 21, 0xCD550D16u, 0xD0ED5187u, 0x69119EB4u},
+    { 37, 0x0C153769u, 0xDEB69207u, 0xBE912490u},
+    { 64, 0xA38AA6DAu, 0x6CF1F813u, 0xB2FEB84Cu},
+    {128, 0x2E22655Au, 0x1CA7B3A4u, 0x6AB3F7F5u},
+    {200, 0x4996571Fu, 0xF61AA907u, 0x8FE42E87u},
+    {254, 0x213B17E0u, 0x18AB92F6u, 0x347716C4u},
+    {255, 0xD5E49FABu, 0x9C33AC0Cu, 0x33EAD211u},
+};
+
+static uint32_t fnv1a(uint32_t hash, uint8_t byte) {
+    hash ^= byte;
+    return hash * 16777619u;
+}
+
+static void fillPseudoRandom(uint8_t* data, size_t length, uint32_t seed) {
+    for (size_t i = 0; i < length; i++) {
+        seed = seed * 1103515245u + 12345u;
+        data[i] = (uint8_t)(seed >> 16);
+    }
+}
+
+// Bit serial CRC8 as originally implemented in Phy::calcCRC8()
+static uint8_t referenceCRC8(const uint8_t* input, uint16_t num_bits) {
+    uint8_t crc = TSUNBPHY_CRC8_INIT;
+    for (uint16_t i = 0; i < num_bits; i++) {
+        uint8_t msb = (crc & 0x80) ? 1 : 0;
+        msb ^= readBit(i, input);
+        crc <<= 1;
+        if (msb) {
+            crc ^= TSUNBPHY_CRC8_POLY;
+        }
+    }
+    return crc;
+}
+
+// Bit serial whitening as originally implemented in Phy::whitenData()
+static void referenceWhitening(uint8_t* data, uint16_t num_bytes) {
+    uint16_t reg = 0x1FF;
+    for (uint16_t byte = 0; byte < num_bytes; byte++) {
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            reg <<= 1;
+            reg ^= 0x1 & (reg >> 9 ^ reg >> 4);
+        }
+        data[byte] ^= (uint8_t)reg;
+    }
+}
+
+template <class PHY>
+static uint32_t encodeHash(uint16_t mpdu_length, uint8_t tsma_pattern, uint32_t seed) {
+    PHY phy;
+    uint8_t mpdu[TSUNBPHY_MAX_PSDU_LENGTH];
+    fillPseudoRandom(mpdu, mpdu_length, seed);
+
+    const uint16_t num_bursts = phy.numRadioBursts(mpdu_length);
+    typename PHY::RadioBurst_t bursts[TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD];
+    const uint32_t freq = phy.encode(bursts, mpdu, mpdu_length, tsma_pattern);
+
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < 4; i++) {
+        hash = fnv1a(hash, (uint8_t)(freq >> (8 * i)));
+    }
+    for (uint16_t b = 0; b < num_bursts; b++) {
+        const uint8_t* data = bursts[b].getBurst();
+        for (uint16_t i = 0; i < bursts[b].getBurstLengthBytes(); i++) {
+            hash = fnv1a(hash, data[i]);
+        }
+        const uint16_t offset = bursts[b].getCarrierOffset();
+        const uint16_t t_rb = bursts[b].get_T_RB();
+        hash = fnv1a(hash, (uint8_t)offset);
+        hash = fnv1a(hash, (uint8_t)(offset >> 8));
+        hash = fnv1a(hash, (uint8_t)t_rb);
+        hash = fnv1a(hash, (uint8_t)(t_rb >> 8));
+    }
+    return hash;
+}
+
+int main() {
+    printf("=== TS-UNB PHY Test ===\n\n");
+    
+    // Test 1: Table driven CRC8 against the bit serial reference
+    printf("Test 1: CRC8 lookup table engine\n");
+    {
+        uint8_t data[TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD];
+        unsigned failures = 0;
+        for (uint32_t seed = 0; seed < 16; seed++) {
+            fillPseudoRandom(data, sizeof(data), seed);
+            for (uint16_t bits = 0; bits <= sizeof(data) * 8; bits++) {
+                const uint8_t expected = referenceCRC8(data, bits);
+                const uint8_t actual = Crc8<TsUnb::TSUNBPHY_CRC8_TABLE>::calc(TSUNBPHY_CRC8_INIT, data, bits);
+                if (expected != actual) {
+                    failures++;
+                }
+            }
+        }
+        if (failures == 0) {
+            printf("✓ CRC8 matches bit serial reference for all bit lengths\n");
+        } else {
+            printf("✗ CRC8 mismatch in %u cases\n", failures);
+            return 1;
+        }
+    }
+    
+    printf("\n");
+    
+    // Test 2: Precomputed whitening sequence against the LFSR
+    printf("Test 2: Whitening sequence\n");
+    {
+        unsigned failures = 0;
+        for (uint16_t i = 0; i < TSUNBPHY_WHITENING_LEN; i++) {
+            uint8_t expected[TSUNBPHY_WHITENING_LEN] = {0};
+            referenceWhitening(expected, i + 1);
+            if (TsUnb::TSUNBPHY_WHITENING_SEQUENCE.entry[i] != expected[i]) {
+                failures++;
+            }
+        }
+        if (failures == 0) {
+            printf("✓ Whitening sequence matches LFSR for %u bytes\n", (unsigned)TSUNBPHY_WHITENING_LEN);
+        } else {
+            printf("✗ Whitening sequence mismatch in %u bytes\n", failures);
+            return 1;
+        }
+    }
+    
+    printf("\n");
+    
+    // Test 3: Complete encoder output against golden vectors
+    printf("Test 3: Phy::encode() golden vectors\n");
+    for (size_t i = 0; i < sizeof(GOLDEN_VECTORS) / sizeof(GOLDEN_VECTORS[0]); i++) {
+        const GoldenVector& v = GOLDEN_VECTORS[i];
+        const uint16_t len = v.mpdu_length;
+        const uint32_t upg1 = encodeHash<PhyUpg1_t>(len, len % 8, len + 1);
+        const uint32_t upg2 = encodeHash<PhyUpg2_t>(len, (len + 3) % 8, len + 7);
+        const uint32_t upg3 = encodeHash<PhyUpg3_t>(len, 0, len + 9);
+        
+        if (upg1 != v.hash_upg1 || upg2 != v.hash_upg2 || upg3 != v.hash_upg3) {
+            printf("✗ MPDU length %u: got %08X %08X %08X, expected %08X %08X %08X\n",
+                   len, upg1, upg2, upg3, v.hash_upg1, v.hash_upg2, v.hash_upg3);
+            return 1;
+        }
+    }
+    printf("✓ Encoder output is bit identical for all golden vectors\n");
+    
+    printf("\n");
+    
+    // Test 4: Compile-time scatter tables, including a fallback to the runtime length
+    printf("Test 4: Compile-time interleaver tables\n");
+    {
+        struct {
+            uint16_t len;
+            uint32_t hash;
+        } results[] = {
+            {10, encodeHash<PhyUpg1Fixed_t<10> >(10, 10 % 8, 10 + 1)},
+            {20, encodeHash<PhyUpg1Fixed_t<20> >(20, 20 % 8, 20 + 1)},
+            {255, encodeHash<PhyUpg1Fixed_t<255> >(255, 255 % 8, 255 + 1)},
+            {64, encodeHash<PhyUpg1Fixed_t<20> >(64, 64 % 8, 64 + 1)},   // Length differs from table
+        };
+        for (const auto& r : results) {
+            uint32_t expected = 0;
+            for (const GoldenVector& v : GOLDEN_VECTORS) {
+                if (v.mpdu_length == r.len) {
+                    expected = v.hash_upg1;
+                }
+            }
+            if (r.hash != expected) {
+                printf("✗ MPDU length %u: got %08X, expected %08X\n", r.len, r.hash, expected);
+                return 1;
+            }
+        }
+        printf("✓ Scatter table output matches golden vectors\n");
+    }
+    
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
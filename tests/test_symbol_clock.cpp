@@ -0,0 +1,295 @@
+/**
+ * @file test_symbol_clock.cpp
+ * @brief Host simulation of the TS-UNB symbol timer
+ *
+ * Replays the timer calls of a transmission (startTimer, addTimerDelay,
+ * waitTimer and the periodic timer interrupts) with the integer SymbolClock
+ * and with the previous float accumulator of RPPicoTsUnb. The interrupts are
+ * rescheduled in whole microseconds like the RP2040 alarm, the time of each
+ * symbol period end is compared with the exact symbol grid (16384/39 us per
+ * symbol). The SymbolClock must stay within 0.5 us without any drift, over
+ * a long run and over the transmission of a maximal 255 byte MPDU.
+ *
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/src/HostTsUnb.h"
+#include "../lib/ts-unb-lib-rfm69/Utils/SymbolClock.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+using namespace TsUnbLib;
+
+static const uint16_t SYMBOL_RATE_MULT = 48;
+
+// Previous implementation: float phase, rounded with (int64_t)(x + 0.5f) in the interrupt
+class LegacyFloatClock {
+public:
+    void init(const uint16_t symbolRateMult) {
+        bitDuration = (float)((double) 1000000 / (49.591064453125 * (double) symbolRateMult));
+        precise = 0;
+        extraDelay = false;
+    }
+    uint32_t start() {
+        if (precise == 0)
+            precise += bitDuration;
+        extraDelay = false;
+        return takeRounded();
+    }
+    void addDelay(const int32_t count) {
+        precise += bitDuration * (count - 1);
+        extraDelay = true;
+    }
+    bool tick() {
+        const bool endOfPeriod = !extraDelay;
+        if (endOfPeriod)
+            precise += bitDuration;
+        else
+            extraDelay = false;
+        takeRounded();
+        return endOfPeriod;
+    }
+    uint32_t getNextUs() const {
+        return (uint32_t) next;
+    }
+
+private:
+    uint32_t takeRounded() {
+        next = (int64_t)(precise + 0.5f);
+        precise -= (float) next;
+        return (uint32_t) next;
+    }
+    float bitDuration;
+    float precise;
+    bool extraDelay;
+    int64_t next;
+};
+
+// Timer call of the transmitter
+struct TimerEvent {
+    enum Type { START, DELAY, WAIT } type;
+    int32_t count;
+};
+
+// Host platform which records the timer calls of Rfm69hw::transmit()
+class RecordingTsUnb : public Host::HostTsUnb<SYMBOL_RATE_MULT> {
+public:
+    void initTimer() {
+        Host::HostTsUnb<SYMBOL_RATE_MULT>::initTimer();
+        events.clear();
+    }
+    void startTimer() {
+        events.push_back({TimerEvent::START, 0});
+    }
+    void addTimerDelay(const int32_t count) {
+        Host::HostTsUnb<SYMBOL_RATE_MULT>::addTimerDelay(count);
+        events.push_back({TimerEvent::DELAY, count});
+    }
+    void waitTimer() {
+        events.push_back({TimerEvent::WAIT, 0});
+    }
+    std::vector<TimerEvent> events;
+};
+
+// EU1 node on the recording platform
+typedef TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+    TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
+    Trx::Rfm69hw<RecordingTsUnb, true, 10, TsUnb::RadioBurst <2,2> >, false> RecordingNode_t;
+
+// Deviation of the symbol period ends from the exact grid, in units of 1/den us
+struct ReplayResult {
+    int64_t maxError;
+    int64_t finalError;
+    int64_t symbols;
+    int64_t duration_us;
+    uint32_t periods;
+};
+
+// Runs the timer calls against a clock, the interrupts are rescheduled relative to the previous one
+template <typename CLOCK>
+static ReplayResult replay(CLOCK& clock, const std::vector<TimerEvent>& events) {
+    const int64_t den = TsUnb::SymbolClock::symbolDurationDen(SYMBOL_RATE_MULT);
+    ReplayResult result = {0, 0, 0, 0, 0};
+    int64_t nextSymbol = 0;    // exact symbol of the next period end
+    int64_t alarm_us = 0;      // time of the next interrupt
+    clock.init(SYMBOL_RATE_MULT);
+    for (const TimerEvent& event : events) {
+        switch (event.type) {
+        case TimerEvent::START:
+            if (nextSymbol == 0)
+                nextSymbol = 1;
+            alarm_us = clock.start();
+            break;
+        case TimerEvent::DELAY:
+            if (event.count > 1)
+                nextSymbol += event.count - 1;
+            clock.addDelay(event.count);
+            break;
+        case TimerEvent::WAIT:
+            while (true) {
+                const int64_t fired_us = alarm_us;
+                const bool endOfPeriod = clock.tick();
+                alarm_us += clock.getNextUs();
+                if (endOfPeriod) {
+                    const int64_t error = fired_us * den - nextSymbol * (int64_t) TsUnb::SymbolClock::SYMBOL_DURATION_NUM;
+                    if (llabs(error) > result.maxError)
+                        result.maxError = llabs(error);
+                    result.finalError = error;
+                    result.symbols = nextSymbol;
+                    result.duration_us = fired_us;
+                    ++result.periods;
+                    ++nextSymbol;
+                    break;
+                }
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+static void printResult(const char* name, const ReplayResult& r) {
+    const double den = TsUnb::SymbolClock::symbolDurationDen(SYMBOL_RATE_MULT);
+    printf("  %-16s max |error| %9.3f us, final error %9.3f us\n", name, r.maxError / den, r.finalError / den);
+}
+
+int main() {
+    printf("=== TS-UNB Symbol Clock Test ===\n\n");
+    const int64_t halfUs = TsUnb::SymbolClock::symbolDurationDen(SYMBOL_RATE_MULT) / 2;
+
+    // Test 1: Symbol duration
+    printf("Test 1: Symbol duration\n");
+    {
+        TsUnb::SymbolClock clock;
+        clock.init(SYMBOL_RATE_MULT);
+        const double exact_us = (double) 1000000 / (49.591064453125 * SYMBOL_RATE_MULT);
+        const double clock_us = (double) TsUnb::SymbolClock::SYMBOL_DURATION_NUM / clock.getDen();
+        if (clock.getDen() != 624 || clock_us != exact_us) {
+            printf("✗ Symbol duration %.12f us, expected %.12f us\n", clock_us, exact_us);
+            return 1;
+        }
+        printf("✓ 262144/624 us = %.9f us\n", clock_us);
+    }
+
+    printf("\n");
+
+    // Test 2: Ten million symbols without delays
+    printf("Test 2: Continuous symbol clock\n");
+    {
+        const std::vector<TimerEvent> events = [] {
+            std::vector<TimerEvent> e = {{TimerEvent::START, 0}};
+            e.resize(10000001, {TimerEvent::WAIT, 0});
+            return e;
+        }();
+        TsUnb::SymbolClock clock;
+        LegacyFloatClock legacy;
+        const ReplayResult r = replay(clock, events);
+        const ReplayResult l = replay(legacy, events);
+        printf("  %lld symbols, %.1f s\n", (long long) r.symbols, r.duration_us / 1e6);
+        printResult("SymbolClock", r);
+        printResult("float (before)", l);
+        if (r.maxError > halfUs) {
+            printf("✗ SymbolClock deviates by more than 0.5 us\n");
+            return 1;
+        }
+        printf("✓ SymbolClock stays within 0.5 us of the exact grid\n");
+    }
+
+    printf("\n");
+
+    // Test 3: Random delays as used for the radio bursts
+    printf("Test 3: Random delays\n");
+    {
+        std::vector<TimerEvent> events = {{TimerEvent::DELAY, 4}, {TimerEvent::START, 0}};
+        uint32_t lfsr = 0xACE1u;
+        for (uint32_t i = 0; i < 100000; i++) {
+            lfsr = lfsr * 1103515245u + 12345u;
+            const int32_t count = (int32_t)((lfsr >> 16) % 2000);
+            if (count > 0)
+                events.push_back({TimerEvent::DELAY, count});
+            events.push_back({TimerEvent::WAIT, 0});
+        }
+        TsUnb::SymbolClock clock;
+        const ReplayResult r = replay(clock, events);
+        printResult("SymbolClock", r);
+        if (r.maxError > halfUs || r.periods != 100000) {
+            printf("✗ SymbolClock deviates by more than 0.5 us or misses periods\n");
+            return 1;
+        }
+        printf("✓ Delays of 1 to 1999 symbols keep the exact grid\n");
+    }
+
+    printf("\n");
+
+    // Test 4: Timer calls of the transmission of a maximal MPDU
+    printf("Test 4: Transmission of a 255 byte MPDU\n");
+    {
+        RecordingNode_t node;
+        node.Mac.setNetworkKey(0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                               0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c);
+        node.Mac.setEui64(0x70, 0xB3, 0xD5, 0x67, 0x70, 0xFF, 0x00, 0x01);
+        node.Mac.setShortAddress(0x00, 0x01);
+        node.init();
+
+        uint8_t payload[TSUNBPHY_MAX_PSDU_LENGTH - MAC_OVERHEAD_SHORT_ADDR];
+        for (uint16_t i = 0; i < sizeof(payload); i++) {
+            payload[i] = (uint8_t) i;
+        }
+        node.send(payload, sizeof(payload));
+
+        TsUnb::SymbolClock clock;
+        LegacyFloatClock legacy;
+        const ReplayResult r = replay(clock, node.Tx.Cpu.events);
+        const ReplayResult l = replay(legacy, node.Tx.Cpu.events);
+        printf("  %u timer periods, %lld symbols, %.3f s\n", r.periods, (long long) r.symbols, r.duration_us / 1e6);
+        printResult("SymbolClock", r);
+        printResult("float (before)", l);
+        if (r.maxError > halfUs || r.symbols != node.Tx.Cpu.elapsedSymbols - 1) {
+            printf("✗ SymbolClock deviates by more than 0.5 us or ends at the wrong symbol\n");
+            return 1;
+        }
+        printf("✓ All burst timings within 0.5 us of the exact grid\n");
+    }
+
+    printf("\n");
+
+    // Test 5: Periods extended in the interrupt as done by the transmit sequencer
+    printf("Test 5: Extended periods, one interrupt per step\n");
+    {
+        const int64_t den = TsUnb::SymbolClock::symbolDurationDen(SYMBOL_RATE_MULT);
+        TsUnb::SymbolClock clock;
+        clock.init(SYMBOL_RATE_MULT);
+        clock.addDelay(4);
+        int64_t alarm_us = clock.start();
+        int64_t symbol = 3;
+        int64_t maxError = 0;
+        uint32_t lfsr = 0x1D872B41u;
+        for (uint32_t step = 0; step < 100000; step++) {
+            if (!clock.tick()) {
+                printf("✗ Interrupt %u is not the end of a period\n", step);
+                return 1;
+            }
+            const int64_t error = alarm_us * den - symbol * (int64_t) TsUnb::SymbolClock::SYMBOL_DURATION_NUM;
+            if (llabs(error) > maxError)
+                maxError = llabs(error);
+
+            lfsr = lfsr * 1103515245u + 12345u;
+            const int32_t count = (int32_t)((lfsr >> 16) % 700) + 1;
+            clock.extendPeriod(count);
+            alarm_us += clock.getNextUs();
+            symbol += count;
+        }
+        printf("  SymbolClock      max |error| %9.3f us\n", maxError / (double) den);
+        if (maxError > halfUs) {
+            printf("✗ SymbolClock deviates by more than 0.5 us\n");
+            return 1;
+        }
+        printf("✓ 100000 steps of 1 to 700 symbols with one interrupt each keep the exact grid\n");
+    }
+
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
@@ -0,0 +1,247 @@
+/**
+ * @file test_tx_pretune.cpp
+ * @brief Test and timing trace of the RFM69 pre-tuning between the bursts
+ *
+ * Transmits packets with and without the PRETUNE option of Rfm69hw on the
+ * emulated SPI of HostTsUnb. Both must send the same frequencies and burst
+ * data and enter TX and sleep mode on the same symbols. With pre-tuning the
+ * frequency and the FIFO are written while the radio sleeps between the
+ * bursts, the wake-up before a burst only sends the FS command.
+ *
+ * The trace of the first bursts and the guard margins are printed for the
+ * symbol rates 2380.371 sym/s and 396.729 sym/s: the time between the FS
+ * command and the TX command minus the SPI transactions of the wake-up and
+ * the RFM69HW start-up from sleep mode (TS_OSC + TS_FS, datasheet maximum
+ * 500 + 150 us, typical 250 + 80 us).
+ *
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/src/HostTsUnb.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+using namespace TsUnbLib;
+
+// SPI clock of the transceiver (MIOTY_SPI_BAUDRATE)
+static const double SPI_CLOCK_HZ = 4e6;
+// RFM69HW start-up from sleep mode to PLL lock (TS_OSC + TS_FS)
+static const double STARTUP_MAX_US = 500 + 150;
+static const double STARTUP_TYP_US = 250 + 80;
+
+// SPI transaction with the symbol time at which it was sent
+struct SpiRecord {
+    int32_t symbol;
+    std::vector<uint8_t> bytes;
+
+    bool isMode(const uint8_t mode) const {
+        return bytes.size() == 2 && bytes[0] == RFM69_WRITE_MODE && bytes[1] == mode;
+    }
+};
+
+// Host platform which records all SPI transactions and the timer wake-ups
+template <uint16_t SYMBOL_RATE_MULT>
+class RecordingTsUnb : public Host::HostTsUnb<SYMBOL_RATE_MULT> {
+public:
+    void spiSend(const uint8_t* const dataOut, const uint8_t numBytes) {
+        Host::HostTsUnb<SYMBOL_RATE_MULT>::spiSend(dataOut, numBytes);
+        records.push_back({this->elapsedSymbols, std::vector<uint8_t>(dataOut, dataOut + numBytes)});
+    }
+    void waitTimer() {
+        ++wakeUps;
+    }
+    std::vector<SpiRecord> records;
+    uint32_t wakeUps = 0;
+};
+
+template <uint16_t SYMBOL_RATE_MULT, bool PRETUNE>
+using Node_t = TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+    TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
+    Trx::Rfm69hw<RecordingTsUnb<SYMBOL_RATE_MULT>, true, 10, TsUnb::RadioBurst <2,2>, PRETUNE>, false>;
+
+// Transmission of one packet
+struct Transmission {
+    std::vector<SpiRecord> records;
+    uint32_t wakeUps;
+    double symbol_us;
+};
+
+template <uint16_t SYMBOL_RATE_MULT, bool PRETUNE>
+static Transmission sendPacket(const uint16_t payloadLength) {
+    Node_t<SYMBOL_RATE_MULT, PRETUNE> node;
+    node.Mac.setNetworkKey(0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                           0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c);
+    node.Mac.setEui64(0x70, 0xB3, 0xD5, 0x67, 0x70, 0xFF, 0x00, 0x01);
+    node.Mac.setShortAddress(0x00, 0x01);
+    node.init();
+    node.Tx.Cpu.records.clear();
+
+    uint8_t payload[TSUNBPHY_MAX_PSDU_LENGTH];
+    for (uint16_t i = 0; i < payloadLength; i++) {
+        payload[i] = (uint8_t)(i * 7 + 3);
+    }
+    node.send(payload, payloadLength);
+    return {node.Tx.Cpu.records, node.Tx.Cpu.wakeUps, RecordingTsUnb<SYMBOL_RATE_MULT>::TS_UNB_BIT_DURATION_US};
+}
+
+// Symbols of the transactions of a mode command, relative to the first one
+static std::vector<int32_t> modeSymbols(const Transmission& t, const uint8_t mode) {
+    std::vector<int32_t> symbols;
+    for (const SpiRecord& r : t.records) {
+        if (r.isMode(mode))
+            symbols.push_back(r.symbol);
+    }
+    for (size_t i = symbols.size(); i-- > 0;) {
+        symbols[i] -= symbols[0];
+    }
+    return symbols;
+}
+
+// Frequency and FIFO transactions in the order they are sent
+static std::vector<std::vector<uint8_t> > loadFrames(const Transmission& t) {
+    std::vector<std::vector<uint8_t> > frames;
+    for (const SpiRecord& r : t.records) {
+        if (r.bytes[0] == RFM69_WRITE_FRF || r.bytes[0] == RFM69_WRITE_FIFO)
+            frames.push_back(r.bytes);
+    }
+    return frames;
+}
+
+// Timing of the bursts of a transmission
+struct BurstTiming {
+    uint32_t bursts;
+    int32_t setupSymbols;     // symbols between FS and TX, -1 if not constant
+    uint32_t wakeBytes;       // maximum SPI bytes sent at the wake-up before a burst
+    uint32_t wakeTransactions;
+    bool loadedInSleep;       // frequency and FIFO only written in sleep mode
+    int32_t minLoadDelay;     // minimum symbols between the end of a burst and loading the next one
+};
+
+static BurstTiming analyze(const Transmission& t) {
+    BurstTiming timing = {0, 0, 0, 0, true, INT32_MAX};
+    bool sleeping = true;
+    int32_t fsSymbol = 0, sleepSymbol = INT32_MIN;
+    for (size_t i = 0; i < t.records.size(); ++i) {
+        const SpiRecord& r = t.records[i];
+        if (r.isMode(RFM69_MODE_FS)) {
+            // All transactions of the wake-up before the burst, sent on the symbol of the FS command
+            uint32_t bytes = 0, transactions = 0;
+            for (size_t j = i + 1; j-- > 0 && t.records[j].symbol == r.symbol && !t.records[j].isMode(RFM69_MODE_SLEEP);) {
+                bytes += t.records[j].bytes.size();
+                ++transactions;
+            }
+            if (bytes > timing.wakeBytes) {
+                timing.wakeBytes = bytes;
+                timing.wakeTransactions = transactions;
+            }
+            sleeping = false;
+            fsSymbol = r.symbol;
+        } else if (r.isMode(RFM69_MODE_TX)) {
+            const int32_t setup = r.symbol - fsSymbol;
+            if (timing.bursts == 0)
+                timing.setupSymbols = setup;
+            else if (setup != timing.setupSymbols)
+                timing.setupSymbols = -1;
+            ++timing.bursts;
+        } else if (r.isMode(RFM69_MODE_SLEEP)) {
+            sleeping = true;
+            sleepSymbol = r.symbol;
+        } else if (r.bytes[0] == RFM69_WRITE_FRF || r.bytes[0] == RFM69_WRITE_FIFO) {
+            if (!sleeping)
+                timing.loadedInSleep = false;
+            if (sleepSymbol != INT32_MIN && r.symbol - sleepSymbol < timing.minLoadDelay)
+                timing.minLoadDelay = r.symbol - sleepSymbol;
+        }
+    }
+    return timing;
+}
+
+static void printTrace(const char* name, const Transmission& t, const uint32_t numBursts) {
+    printf("  %s\n", name);
+    uint32_t bursts = 0;
+    for (size_t i = 0; i < t.records.size() && bursts < numBursts; ++i) {
+        const SpiRecord& r = t.records[i];
+        const char* what = "";
+        if (r.isMode(RFM69_MODE_FS)) what = "FS";
+        else if (r.isMode(RFM69_MODE_TX)) what = "TX";
+        else if (r.isMode(RFM69_MODE_SLEEP)) what = "SLEEP";
+        else if (r.bytes[0] == RFM69_WRITE_FRF) what = "FRF";
+        else if (r.bytes[0] == RFM69_WRITE_FIFO) what = "FIFO";
+        else continue;
+        printf("    symbol %5d  %10.1f us  %-5s %2zu bytes\n", r.symbol, r.symbol * t.symbol_us, what, r.bytes.size());
+        if (r.isMode(RFM69_MODE_SLEEP))
+            ++bursts;
+    }
+}
+
+static void printMargins(const char* name, const Transmission& t, const BurstTiming& timing) {
+    const double setup_us = timing.setupSymbols * t.symbol_us;
+    const double spi_us = timing.wakeBytes * 8e6 / SPI_CLOCK_HZ;
+    printf("  %-12s FS->TX %d symbols = %7.1f us, wake-up SPI %2u bytes in %u transactions = %4.1f us,"
+           " guard %7.1f us (max start-up), FS dwell %7.1f us (typ), %.1f wake-ups per burst\n",
+           name, timing.setupSymbols, setup_us, timing.wakeBytes, timing.wakeTransactions, spi_us,
+           setup_us - spi_us - STARTUP_MAX_US, setup_us - spi_us - STARTUP_TYP_US,
+           (double) t.wakeUps / timing.bursts);
+}
+
+// Compares a transmission with and without pre-tuning
+template <uint16_t SYMBOL_RATE_MULT>
+static bool checkRate(const uint16_t payloadLength, const bool print) {
+    const Transmission plain = sendPacket<SYMBOL_RATE_MULT, false>(payloadLength);
+    const Transmission pretuned = sendPacket<SYMBOL_RATE_MULT, true>(payloadLength);
+    const BurstTiming plainTiming = analyze(plain);
+    const BurstTiming pretunedTiming = analyze(pretuned);
+
+    if (modeSymbols(plain, RFM69_MODE_TX) != modeSymbols(pretuned, RFM69_MODE_TX) ||
+        modeSymbols(plain, RFM69_MODE_SLEEP) != modeSymbols(pretuned, RFM69_MODE_SLEEP)) {
+        printf("✗ %.3f sym/s, payload %u: TX or sleep symbols differ\n", 1e6 / plain.symbol_us, payloadLength);
+        return false;
+    }
+    if (loadFrames(plain) != loadFrames(pretuned)) {
+        printf("✗ %.3f sym/s, payload %u: frequencies or burst data differ\n", 1e6 / plain.symbol_us, payloadLength);
+        return false;
+    }
+    if (pretunedTiming.setupSymbols <= 0 || !pretunedTiming.loadedInSleep || pretunedTiming.minLoadDelay < 1 ||
+        pretunedTiming.wakeTransactions != 1 ||
+        pretunedTiming.setupSymbols * pretuned.symbol_us - pretunedTiming.wakeBytes * 8e6 / SPI_CLOCK_HZ < STARTUP_MAX_US) {
+        printf("✗ %.3f sym/s, payload %u: pre-tuning timing violated\n", 1e6 / plain.symbol_us, payloadLength);
+        return false;
+    }
+    printf("✓ %8.3f sym/s, payload %3u bytes: %u bursts, same TX symbols and data, loaded in sleep mode\n",
+           1e6 / plain.symbol_us, payloadLength, pretunedTiming.bursts);
+
+    if (print) {
+        printMargins("loop", plain, plainTiming);
+        printMargins("pre-tuning", pretuned, pretunedTiming);
+        printTrace("trace of the first two bursts without pre-tuning", plain, 2);
+        printTrace("trace of the first two bursts with pre-tuning", pretuned, 2);
+    }
+    return true;
+}
+
+int main() {
+    printf("=== TS-UNB RFM69 Pre-tuning Test ===\n\n");
+
+    const uint16_t payloadLengths[] = {10, 100, TSUNBPHY_MAX_PSDU_LENGTH - MAC_OVERHEAD_SHORT_ADDR};
+
+    // Test 1: Standard symbol rate
+    printf("Test 1: 2380.371 sym/s\n");
+    for (const uint16_t payloadLength : payloadLengths) {
+        if (!checkRate<48>(payloadLength, payloadLength == 10))
+            return 1;
+    }
+
+    printf("\n");
+
+    // Test 2: Low symbol rate, the start-up fits into one symbol
+    printf("Test 2: 396.729 sym/s\n");
+    for (const uint16_t payloadLength : payloadLengths) {
+        if (!checkRate<8>(payloadLength, payloadLength == 10))
+            return 1;
+    }
+
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file test_tx_sequence.cpp
+ * @brief Test of the command list of the transmit sequencer
+ *
+ * Transmits packets once with the timer and SPI loop of Rfm69hw and once with a
+ * host transmit sequencer, which replays the command list on the emulated SPI.
+ * Both must produce the same SPI transactions at the same symbol instants.
+ *
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/src/HostTsUnb.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+using namespace TsUnbLib;
+
+// SPI transaction with the symbol time at which it was sent
+struct SpiRecord {
+    int32_t symbol;
+    std::vector<uint8_t> bytes;
+
+    bool operator==(const SpiRecord& other) const {
+        return symbol == other.symbol && bytes == other.bytes;
+    }
+};
+
+// Host platform which records all SPI transactions
+class RecordingTsUnb : public Host::HostTsUnb<48> {
+public:
+    void spiSend(const uint8_t* const dataOut, const uint8_t numBytes) {
+        Host::HostTsUnb<48>::spiSend(dataOut, numBytes);
+        records.push_back({elapsedSymbols, std::vector<uint8_t>(dataOut, dataOut + numBytes)});
+    }
+    std::vector<SpiRecord> records;
+};
+
+// Host platform with a transmit sequencer, the command list is replayed on the emulated SPI
+template <uint16_t MAX_STEPS, uint16_t MAX_FRAME_BYTES>
+class SequencerTsUnb : public RecordingTsUnb {
+public:
+    typedef Trx::TxSequence<MAX_STEPS, MAX_FRAME_BYTES> TxSequence_t;
+
+    SequencerTsUnb() : sequenceRuns(0) {
+    }
+
+    TxSequence_t& getTxSequence() {
+        return sequence;
+    }
+
+    bool runSequence() {
+        ++sequenceRuns;
+        for (uint16_t stepIdx = 0; stepIdx < sequence.getNumSteps(); ++stepIdx) {
+            const typename TxSequence_t::Step& step = sequence.getStep(stepIdx);
+            addTimerDelay(step.delay);
+            const uint8_t* frames = sequence.getFrames(step);
+            for (uint16_t i = 0; i < step.frameLength; i += frames[i] + 1) {
+                spiSend(&frames[i + 1], frames[i]);
+            }
+        }
+        return true;
+    }
+
+    TxSequence_t sequence;
+    uint32_t sequenceRuns;
+};
+
+// Capacity of the RP2040 sequencer
+typedef SequencerTsUnb<3 * 260, 22 * 260> FullSequencer_t;
+// Too short for any packet, Rfm69hw has to fall back to the loop
+typedef SequencerTsUnb<3 * 260, 22 * 20> ShortSequencer_t;
+
+template <class CPU>
+using Node_t = TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+    TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
+    Trx::Rfm69hw<CPU, true, 10, TsUnb::RadioBurst <2,2> >, false>;
+
+template <class CPU>
+using PretuneNode_t = TsUnb::SimpleNode<TsUnb::FixedUplinkMac,
+    TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst <2,2> >,
+    Trx::Rfm69hw<CPU, true, 10, TsUnb::RadioBurst <2,2>, true>, false>;
+
+// Capacity of the RP2040 sequencer with pre-tuning
+typedef SequencerTsUnb<4 * 260, 22 * 260> PretuneSequencer_t;
+
+static_assert(Trx::HasTxSequencer<FullSequencer_t>::value, "Sequencer not detected");
+static_assert(!Trx::HasTxSequencer<RecordingTsUnb>::value, "Sequencer detected without TxSequence_t");
+
+// Sends one packet and returns the SPI transactions of the transmission
+template <class NODE>
+static std::vector<SpiRecord> sendPacket(NODE& node, const uint16_t payloadLength) {
+    node.Mac.setNetworkKey(0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                           0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c);
+    node.Mac.setEui64(0x70, 0xB3, 0xD5, 0x67, 0x70, 0xFF, 0x00, 0x01);
+    node.Mac.setShortAddress(0x00, 0x01);
+    node.init();
+    node.Tx.Cpu.records.clear();
+
+    uint8_t payload[TSUNBPHY_MAX_PSDU_LENGTH];
+    for (uint16_t i = 0; i < payloadLength; i++) {
+        payload[i] = (uint8_t)(i * 7 + 3);
+    }
+    node.send(payload, payloadLength);
+    return node.Tx.Cpu.records;
+}
+
+int main() {
+    printf("=== TS-UNB Transmit Sequence Test ===\n\n");
+
+    const uint16_t payloadLengths[] = {10, 100, TSUNBPHY_MAX_PSDU_LENGTH - MAC_OVERHEAD_SHORT_ADDR};
+
+    // Test 1: The command list reproduces the transmission of the loop
+    printf("Test 1: Sequencer and loop send the same transactions\n");
+    for (const uint16_t payloadLength : payloadLengths) {
+        Node_t<RecordingTsUnb> loopNode;
+        Node_t<FullSequencer_t> sequencerNode;
+        const std::vector<SpiRecord> loop = sendPacket(loopNode, payloadLength);
+        const std::vector<SpiRecord> sequenced = sendPacket(sequencerNode, payloadLength);
+        const FullSequencer_t::TxSequence_t& sequence = sequencerNode.Tx.Cpu.sequence;
+
+        if (sequencerNode.Tx.Cpu.sequenceRuns != 1) {
+            printf("✗ Payload %u: sequencer not used\n", payloadLength);
+            return 1;
+        }
+        if (loop != sequenced) {
+            printf("✗ Payload %u: %zu transactions of the loop, %zu of the sequencer differ\n",
+                   payloadLength, loop.size(), sequenced.size());
+            return 1;
+        }
+        printf("✓ Payload %3u bytes: %zu transactions, %u steps, %u command bytes\n", payloadLength,
+               loop.size(), sequence.getNumSteps(), sequence.getNumFrameBytes());
+    }
+
+    printf("\n");
+
+    // Test 2: Fallback to the loop if the command list is too short
+    printf("Test 2: Fallback for a too short command list\n");
+    {
+        Node_t<RecordingTsUnb> loopNode;
+        Node_t<ShortSequencer_t> sequencerNode;
+        const std::vector<SpiRecord> loop = sendPacket(loopNode, 100);
+        const std::vector<SpiRecord> fallback = sendPacket(sequencerNode, 100);
+        if (sequencerNode.Tx.Cpu.sequenceRuns != 0 || loop != fallback) {
+            printf("✗ Fallback to the loop failed\n");
+            return 1;
+        }
+        printf("✓ Sequencer not used, %zu transactions sent by the loop\n", fallback.size());
+    }
+
+    printf("\n");
+
+    // Test 3: Command list with pre-tuning, the next burst is loaded between the bursts
+    printf("Test 3: Sequencer and loop with pre-tuning\n");
+    for (const uint16_t payloadLength : payloadLengths) {
+        PretuneNode_t<RecordingTsUnb> loopNode;
+        PretuneNode_t<PretuneSequencer_t> sequencerNode;
+        const std::vector<SpiRecord> loop = sendPacket(loopNode, payloadLength);
+        const std::vector<SpiRecord> sequenced = sendPacket(sequencerNode, payloadLength);
+        const PretuneSequencer_t::TxSequence_t& sequence = sequencerNode.Tx.Cpu.sequence;
+
+        if (sequencerNode.Tx.Cpu.sequenceRuns != 1 || loop != sequenced) {
+            printf("✗ Payload %u: sequencer not used or %zu transactions of the loop, %zu of the sequencer differ\n",
+                   payloadLength, loop.size(), sequenced.size());
+            return 1;
+        }
+        printf("✓ Payload %3u bytes: %zu transactions, %u steps, %u command bytes\n", payloadLength,
+               loop.size(), sequence.getNumSteps(), sequence.getNumFrameBytes());
+    }
+
+    printf("\n=== All tests completed successfully! ===\n");
+    return 0;
+}
@@ -0,0 +1,417 @@
+/**
+ * @file tsunb_bench.cpp
+ * @brief Host benchmark of the complete TS-UNB encoder stack
+ *
+ * Reports ns/packet and packets/s for each stage of the uplink encoding
+ * across MPDU lengths. The MAC stages use the AES of the library in the
+ * same way as FixedUplinkMac, the PHY stages the lookup tables of the
+ * library as Phy::encode(). "MAC encrypt" and "CMAC" are the separate passes
+ * of the original implementation, "CTR+CMAC fused" the single pass of AesCmac
+ * that FixedUplinkMac uses now. The totals run the library code unchanged:
+ * FixedUplinkMac::encode(), Phy::encode() and SimpleNode::send() with the
+ * stub platform of HostTsUnb.h. "node send in place" is SimpleNode::sendInPlace(),
+ * where the payload is already in the MPDU buffer. "transmit SPI" is the SPI
+ * traffic of one transmission and its wire time without chip select handling.
+ *
+ * FixedUplinkMac expands the network key and generates the CMAC subkeys
+ * only after setNetworkKey(). The "key setup" stage is this work, i.e. the
+ * saving per uplink compared to "MAC encode (new key)", which changes the
+ * key before every packet like the original implementation.
+ *
+ * "MAC prepare next" is FixedUplinkMac::prepareNextFrame(), which runs in
+ * idle time before the payload exists. "MAC encode (prepared)" is the
+ * remaining work of encode() after the trigger, measured as prepare plus
+ * encode minus the prepare time.
+ *
+ * Built with -DTSUNB_HOST_BUILD=ON, run: ./tsunb_bench [iterations]
+ * When built for the RP2040 (PICO_ON_DEVICE, target tsunb_bench_rp2040 of the
+ * firmware build) the results are reported in CPU cycles measured with SysTick
+ * and printed via stdio.
+ *
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/src/HostTsUnb.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#define BENCH_UNIT "cyc"
+#else
+#include <chrono>
+#define BENCH_UNIT "ns"
+#endif
+
+using namespace TsUnbLib;
+
+typedef Host::TsUnb_EU1_Host_t Node_t;
+typedef TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, TsUnb::RadioBurst<2, 2> > Phy_t;
+typedef Phy_t::RadioBurst_t Burst_t;
+
+static const uint16_t MPDU_LENGTHS[] = {20, 32, 64, 128, 192, 255};
+static const uint16_t MAX_BURSTS = TSUNBPHY_MAX_PSDU_LENGTH + TSUNBPHY_OVERHEAD;
+
+static uint32_t g_iterations = 20000;
+
+// SPI clock of the transceiver (MIOTY_SPI_BAUDRATE)
+static const double SPI_CLOCK_HZ = 4e6;
+
+// Prevents the compiler from removing the benchmarked code
+static volatile uint32_t g_sink;
+
+static const uint8_t NETWORK_KEY[16] = {
+    0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6, 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+static const uint8_t EUI64[8] = {0x70, 0xB3, 0xD5, 0x67, 0x70, 0x00, 0x00, 0x01};
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+// Returns the average CPU cycles of func, each call is measured individually
+// as the 24 bit SysTick counter would overflow for the complete loop
+template <typename F>
+static double measure(F func) {
+    uint64_t cycles = 0;
+    for (uint32_t i = 0; i < g_iterations; i++) {
+        const uint32_t start = systick_hw->cvr;
+        func(i);
+        const uint32_t stop = systick_hw->cvr;
+        cycles += (start - stop) & 0x00FFFFFF;  // SysTick counts down
+    }
+    return (double)cycles / g_iterations;
+}
+
+static double unitsPerSecond() {
+    return clock_get_hz(clk_sys);
+}
+#else
+// Returns the average duration of func in ns
+template <typename F>
+static double measure(F func) {
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < g_iterations; i++) {
+        func(i);
+    }
+    const auto stop = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(stop - start).count() / g_iterations;
+}
+
+static double unitsPerSecond() {
+    return 1e9;
+}
+#endif
+
+static void report(const char* stage, double duration) {
+    printf("  %-22s %12.1f %14.0f\n", stage, duration, unitsPerSecond() / duration);
+}
+
+// Sums up the data of all bursts to keep the compiler from removing unused bursts
+static uint32_t burstSum(const Burst_t* bursts, uint16_t num_bursts) {
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < num_bursts; i++) {
+        for (uint16_t j = 0; j < Burst_t::BURST_LENGTH_BYTES; j++) {
+            sum += bursts[i].getBurst()[j];
+        }
+        sum += bursts[i].getCarrierOffset() + bursts[i].get_T_RB();
+    }
+    return sum;
+}
+
+// The bursts of the longest packet do not fit on the RP2040 stack (2 kB), the benchmarks use
+// static bursts and reset the bursts of the current packet instead of constructing new ones
+static Burst_t* resetBursts(Burst_t* bursts, uint16_t num_bursts) {
+    for (uint16_t i = 0; i < num_bursts; i++) {
+        bursts[i] = Burst_t();
+    }
+    return bursts;
+}
+
+// AES with the expanded network key, as cached by FixedUplinkMac
+static TsUnb::Aes128 g_aes;
+// CMAC subkeys of the network key, as cached by FixedUplinkMac
+static uint8_t g_k1[16], g_k2[16];
+
+// AES-CTR encryption of the MAC payload as done by FixedUplinkMac::encode()
+static uint32_t macEncrypt(uint8_t* data, uint16_t len, uint32_t counter) {
+    TsUnb::Aes128& aes = g_aes;
+    uint8_t iv[16] = {0};
+    for (uint8_t i = 0; i < 8; i++) {
+        iv[i] = EUI64[i];
+    }
+    iv[10] = counter >> 24;
+    iv[11] = counter >> 16;
+    iv[12] = counter >> 8;
+    iv[13] = counter;
+
+    for (uint8_t block = 0; block * 16 < len; block++) {
+        uint8_t keyStream[16];
+        iv[15] = block;
+        aes.chipher(iv, keyStream);
+        for (uint8_t i = 0; i < 16 && block * 16 + i < len; i++) {
+            data[block * 16 + i] ^= keyStream[i];
+        }
+    }
+    return data[0];
+}
+
+static void cmacShift(const uint8_t* in, uint8_t* out) {
+    const uint8_t msb = in[0] >> 7;
+    for (uint8_t i = 0; i < 15; i++) {
+        out[i] = (uint8_t)(in[i] << 1) | (in[i + 1] >> 7);
+    }
+    out[15] = (uint8_t)(in[15] << 1) ^ (msb ? CMAC_RB : 0);
+}
+
+// Key expansion and CMAC subkeys, done by FixedUplinkMac only after setNetworkKey()
+static uint32_t macKeySetup(TsUnb::Aes128& aes, uint8_t* k1, uint8_t* k2) {
+    aes.init(NETWORK_KEY);
+    for (uint8_t i = 0; i < 16; i++) {
+        k1[i] = 0;
+    }
+    aes.chipher(k1, k1);
+    cmacShift(k1, k1);
+    cmacShift(k1, k2);
+    return k2[15];
+}
+
+// CMAC over the initialization vector block and the MPDU as done by FixedUplinkMac::encode()
+static uint32_t macCmac(const uint8_t* data, uint16_t len) {
+    TsUnb::Aes128& aes = g_aes;
+    const uint8_t* const k1 = g_k1;
+    const uint8_t* const k2 = g_k2;
+
+    uint8_t state[16] = {0};
+    for (uint8_t i = 0; i < 8; i++) {
+        state[i] = EUI64[i];
+    }
+    state[14] = 0xFF;
+    state[15] = 0xFF;
+    aes.chipher(state, state);
+
+    uint16_t pos = 0;
+    for (; len - pos > 16; pos += 16) {
+        for (uint8_t i = 0; i < 16; i++) {
+            state[i] ^= data[pos + i];
+        }
+        aes.chipher(state, state);
+    }
+    const uint8_t rest = len - pos;
+    const uint8_t* subkey = rest == 16 ? k1 : k2;
+    for (uint8_t i = 0; i < 16; i++) {
+        state[i] ^= subkey[i];
+        if (i < rest)
+            state[i] ^= data[pos + i];
+        else if (i == rest)
+            state[i] ^= 0x80;
+    }
+    aes.chipher(state, state);
+    return state[0];
+}
+
+// Streaming CMAC with the expanded network key, as used by FixedUplinkMac
+static TsUnb::AesCmac g_cmac;
+
+// CTR encryption of the MAC payload and CMAC of the MPDU in one pass, as done by FixedUplinkMac::encode()
+static uint32_t macFused(uint8_t* mpdu, uint16_t len, uint32_t counter) {
+    uint8_t iv[16] = {0};
+    for (uint8_t i = 0; i < 8; i++) {
+        iv[i] = EUI64[i];
+    }
+    iv[10] = counter >> 24;
+    iv[11] = counter >> 16;
+    iv[12] = counter >> 8;
+    iv[13] = counter;
+    iv[14] = 0xFF;
+    iv[15] = 0xFF;
+
+    uint8_t state[16];
+    g_cmac.aes().chipher(iv, state);
+    g_cmac.init(state);
+    const uint16_t header = MAC_OVERHEAD_SHORT_ADDR - 4;
+    g_cmac.update(mpdu, header);
+    iv[14] = 0;
+    for (uint16_t pos = header; pos < len; pos += 16) {
+        uint8_t keyStream[16];
+        iv[15] = (pos - header) >> 4;
+        g_cmac.aes().chipher(iv, keyStream);
+        g_cmac.updateEncrypt(&mpdu[pos], (len - pos < 16) ? len - pos : 16, keyStream);
+    }
+    g_cmac.final(state);
+    return state[0];
+}
+
+// Payload and header CRC as calculated by Phy::encode()
+static uint32_t phyCrc(const uint8_t* mpdu, uint16_t len) {
+    uint8_t crc = Crc8<TsUnb::TSUNBPHY_CRC8_TABLE>::calc(TSUNBPHY_CRC8_INIT, mpdu, len * 8);
+    crc = Crc8<TsUnb::TSUNBPHY_CRC8_TABLE>::updateBits(crc, 0, 2);
+    const uint8_t header[2] = {crc, (uint8_t)len};
+    return Crc8<TsUnb::TSUNBPHY_CRC8_TABLE>::calc(TSUNBPHY_CRC8_INIT, header, 16);
+}
+
+static uint32_t phyWhitening(uint8_t* psdu, uint16_t num_bytes) {
+    for (uint16_t i = 0; i < num_bytes; i++) {
+        psdu[i] ^= TsUnb::TSUNBPHY_WHITENING_SEQUENCE.entry[i];
+    }
+    return psdu[num_bytes - 1];
+}
+
+static uint32_t phyConvolution(const uint8_t* psdu, uint16_t num_bytes, uint32_t* coded) {
+    ConvEncoder<TsUnb::TSUNBPHY_CONV_TABLES> encoder(psdu[num_bytes - 3]);
+    for (uint16_t i = 0; i < num_bytes; i++) {
+        coded[i] = encoder.encodeByte(psdu[i]);
+    }
+    return coded[num_bytes - 1];
+}
+
+// Writes the coded bits onto the bursts and commits them, the bits are distributed
+// round robin over the bursts, which has the same cost as the actual interleaver
+static uint32_t phyInterleave(const uint32_t* coded, uint16_t num_bursts) {
+    static Burst_t storage[MAX_BURSTS];
+    Burst_t* const bursts = resetBursts(storage, num_bursts);
+    uint32_t subPacketBits[MAX_BURSTS] = {0};
+    uint16_t burstIdx = 0;
+    for (uint16_t i = 0; i < num_bursts; i++) {
+        for (uint8_t bit = 0; bit < 24; bit++) {
+            bursts[burstIdx].writeSubPacketBit((coded[i] >> (23 - bit)) & 1, burstIdx, subPacketBits[burstIdx]);
+            if (++burstIdx == num_bursts)
+                burstIdx = 0;
+        }
+    }
+    for (uint16_t i = 0; i < num_bursts; i++) {
+        bursts[i].commitSubPacket(i, subPacketBits[i]);
+    }
+    return burstSum(bursts, num_bursts);
+}
+
+// TSMA core frame schedule and extension frame LFSR as applied by Phy::encode()
+static uint32_t phyTsma(Burst_t* bursts, uint16_t num_bursts, uint8_t pattern, uint16_t lfsr) {
+    const Phy_t::TsmaSchedule& schedule = Phy_t::getTsmaSchedule(pattern);
+    for (uint16_t i = 0; i < TSUNBPHY_NUM_CORE_BURSTS; i++) {
+        bursts[i].setCarrierOffset(schedule.burst[i].carrierOffset);
+        bursts[i].set_T_RB(schedule.burst[i].T_RB);
+    }
+    for (uint16_t i = TSUNBPHY_NUM_CORE_BURSTS; i < num_bursts; i++) {
+        lfsr = (lfsr >> 1) ^ ((lfsr & 1) ? TSUNBPHY_EXT_FRAME_POLY : 0);
+        bursts[i].setCarrierOffset(((lfsr >> 8) % 25) * 39);
+        bursts[i - 1].set_T_RB(TSUNBPHY_TIME_SPACING_UPG1 + (lfsr % 128));
+    }
+    bursts[num_bursts - 1].set_T_RB(0);
+    return bursts[num_bursts - 1].getCarrierOffset();
+}
+
+static void benchLength(Node_t& node, uint16_t mpdu_len) {
+    const uint16_t payload_len = mpdu_len - MAC_OVERHEAD_SHORT_ADDR;
+    const uint16_t num_bursts = Phy_t().numRadioBursts(mpdu_len);
+
+    // Static, the stack of the RP2040 is needed by SimpleNode::send()
+    static uint8_t payload[TSUNBPHY_MAX_PSDU_LENGTH];
+    for (uint16_t i = 0; i < payload_len; i++) {
+        payload[i] = (uint8_t)(i * 7 + 3);
+    }
+    static uint8_t mpdu[TSUNBPHY_MAX_PSDU_LENGTH];
+    static uint8_t psdu[MAX_BURSTS];
+    static uint32_t coded[MAX_BURSTS];
+    static Burst_t bursts[MAX_BURSTS];
+    TsUnb::FixedUplinkMac& mac = node.Mac;
+    mac.encode(mpdu, payload, payload_len);
+    for (uint16_t i = 0; i < mpdu_len; i++) {
+        psdu[TSUNBPHY_PAYLOAD_DATA_POS + i] = mpdu[i];
+    }
+
+    printf("MPDU %u bytes (%u radio bursts)\n", mpdu_len, num_bursts);
+    printf("  %-22s %12s %14s\n", "stage", BENCH_UNIT "/packet", "packets/s");
+
+    report("key setup", measure([&](uint32_t) {
+        TsUnb::Aes128 aes;
+        uint8_t k1[16], k2[16];
+        g_sink = macKeySetup(aes, k1, k2);
+    }));
+    report("MAC encrypt", measure([&](uint32_t i) { g_sink = macEncrypt(payload, payload_len, i); }));
+    report("CMAC", measure([&](uint32_t i) { mpdu[0] = (uint8_t)i; g_sink = macCmac(mpdu, mpdu_len - 4); }));
+    report("CTR+CMAC fused", measure([&](uint32_t i) { g_sink = macFused(mpdu, mpdu_len - 4, i); }));
+    report("CRC", measure([&](uint32_t i) { mpdu[0] = (uint8_t)i; g_sink = phyCrc(mpdu, mpdu_len); }));
+    report("whitening", measure([&](uint32_t i) { g_sink = phyWhitening(psdu, num_bursts); }));
+    report("convolution", measure([&](uint32_t i) { psdu[0] = (uint8_t)i; g_sink = phyConvolution(psdu, num_bursts, coded); }));
+    report("interleave", measure([&](uint32_t i) { coded[0] = i; g_sink = phyInterleave(coded, num_bursts); }));
+    report("TSMA", measure([&](uint32_t i) { g_sink = phyTsma(bursts, num_bursts, i & 7, 0x8000u | (uint16_t)i); }));
+
+    printf("  totals\n");
+    report("MAC encode", measure([&](uint32_t i) { g_sink = mac.encode(mpdu, payload, payload_len); }));
+    const double t_prepare = measure([&](uint32_t) {
+        mac.prepareNextFrame();
+        g_sink = mac.extPkgCnt;
+    });
+    report("MAC prepare next", t_prepare);
+    report("MAC encode (prepared)", measure([&](uint32_t) {
+        mac.prepareNextFrame();
+        g_sink = mac.encode(mpdu, payload, payload_len);
+    }) - t_prepare);
+    report("MAC encode (new key)", measure([&](uint32_t i) {
+        const uint8_t* k = NETWORK_KEY;
+        mac.setNetworkKey(k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7],
+                          k[8], k[9], k[10], k[11], k[12], k[13], k[14], k[15]);
+        g_sink = mac.encode(mpdu, payload, payload_len);
+    }));
+    report("PHY encode", measure([&](uint32_t i) {
+        static Burst_t storage[MAX_BURSTS];
+        Burst_t* const phy_bursts = resetBursts(storage, num_bursts);
+        mpdu[0] = (uint8_t)i;
+        g_sink = Phy_t().encode(phy_bursts, mpdu, mpdu_len, i & 7) + burstSum(phy_bursts, num_bursts);
+    }));
+    report("node send (stub TX)", measure([&](uint32_t i) { g_sink = node.send(payload, payload_len); }));
+    static uint8_t frame[TsUnb::FixedUplinkMac::HEADROOM + TSUNBPHY_MAX_PSDU_LENGTH + TsUnb::FixedUplinkMac::TAG_LENGTH];
+    report("node send in place", measure([&](uint32_t i) {
+        // The payload stays encrypted from the previous packet, same work for the encoder
+        g_sink = node.sendInPlace(frame, payload_len);
+    }));
+
+    // SPI traffic of one transmission, counted by the SPI emulation of HostTsUnb
+    node.Tx.Cpu.spiTransfers = 0;
+    node.Tx.Cpu.spiBytes = 0;
+    node.send(payload, payload_len);
+    const uint32_t spi_transfers = node.Tx.Cpu.spiTransfers;
+    const uint32_t spi_bytes = node.Tx.Cpu.spiBytes;
+    printf("  transmit SPI: %u transactions, %u bytes, %.2f ms at %.0f MHz (%.1f transactions, %.1f bytes per burst)\n",
+           (unsigned)spi_transfers, (unsigned)spi_bytes, spi_bytes * 8e3 / SPI_CLOCK_HZ, SPI_CLOCK_HZ / 1e6,
+           (double)spi_transfers / num_bursts, (double)spi_bytes / num_bursts);
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+    stdio_init_all();
+    sleep_ms(2000);  // Give the USB serial connection time to come up
+
+    // SysTick counts the processor clock, full 24 bit range
+    systick_hw->rvr = 0x00FFFFFF;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5;
+#endif
+    macKeySetup(g_aes, g_k1, g_k2);
+    g_cmac.setKey(NETWORK_KEY);
+
+    if (argc > 1) {
+        g_iterations = (uint32_t)strtoul(argv[1], NULL, 0);
+        if (g_iterations == 0)
+            g_iterations = 1;
+    }
+
+    Node_t node;
+    node.Mac.setNetworkKey(NETWORK_KEY[0], NETWORK_KEY[1], NETWORK_KEY[2], NETWORK_KEY[3],
+                           NETWORK_KEY[4], NETWORK_KEY[5], NETWORK_KEY[6], NETWORK_KEY[7],
+                           NETWORK_KEY[8], NETWORK_KEY[9], NETWORK_KEY[10], NETWORK_KEY[11],
+                           NETWORK_KEY[12], NETWORK_KEY[13], NETWORK_KEY[14], NETWORK_KEY[15]);
+    node.Mac.setAddress(EUI64[0], EUI64[1], EUI64[2], EUI64[3], EUI64[4], EUI64[5], EUI64[6], EUI64[7]);
+    if (node.init() < 0) {
+        printf("Node initialization failed\n");
+        return 1;
+    }
+
+    printf("=== TS-UNB encoder benchmark (EU1, %u iterations) ===\n\n", (unsigned)g_iterations);
+    for (uint16_t len : MPDU_LENGTHS) {
+        benchLength(node, len);
+    }
+    return 0;
+}
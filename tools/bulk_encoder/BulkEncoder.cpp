@@ -0,0 +1,80 @@
+/**
+ * @file BulkEncoder.cpp
+ * @brief Multi-threaded host encoder for synthetic TS-UNB uplink traffic
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "BulkEncoder.h"
+
+#include <cstring>
+
+namespace TsUnbLib {
+namespace Host {
+
+typedef TsUnb::RadioBurst<2, 2> Burst_t;
+typedef TsUnb::Phy<14224261, 14224261, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, Burst_t> PhyEu0_t;
+typedef TsUnb::Phy<14224261, 14222623, 39, 39, TsUnb::TsUnb_UPG1, 0, 3, Burst_t> PhyEu1_t;
+typedef TsUnb::Phy<14215168, 14202061, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, Burst_t> PhyEu2_t;
+typedef TsUnb::Phy<15014297, 15001190, 468, 39, TsUnb::TsUnb_UPG1, 0, 3, Burst_t> PhyUs0_t;
+
+void bulkNodeEui64(const BulkEncodeConfig& config, uint32_t nodeIdx, uint8_t eui64[8]) {
+    uint32_t carry = nodeIdx;
+    for (int i = 7; i >= 0; i--) {
+        carry += config.baseEui64[i];
+        eui64[i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+}
+
+void bulkPayload(uint32_t nodeIdx, uint32_t packetCounter, uint8_t* payload, uint16_t length) {
+    // xorshift32, the seed must not be 0
+    uint32_t state = (nodeIdx * 0x9E3779B9u) ^ (packetCounter * 0x85EBCA6Bu) ^ 0x2545F491u;
+    if (state == 0) {
+        state = 1;
+    }
+    for (uint16_t i = 0; i < length; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        payload[i] = (uint8_t)state;
+    }
+}
+
+bool bulkParseRegion(const char* name, BulkRegion& region) {
+    static const struct {
+        const char* name;
+        BulkRegion region;
+    } REGIONS[] = {
+        {"eu0", BULK_REGION_EU0},
+        {"eu1", BULK_REGION_EU1},
+        {"eu2", BULK_REGION_EU2},
+        {"us0", BULK_REGION_US0},
+    };
+    for (const auto& r : REGIONS) {
+        if (strcmp(name, r.name) == 0) {
+            region = r.region;
+            return true;
+        }
+    }
+    return false;
+}
+
+BulkEncodeStats bulkEncodeRegion(BulkRegion region, const BulkEncodeConfig& config,
+                                 const BulkSink& sink, WorkStealingPool& pool) {
+    switch (region) {
+    case BULK_REGION_EU0:
+        return bulkEncode<PhyEu0_t>(config, sink, pool);
+    case BULK_REGION_EU1:
+        return bulkEncode<PhyEu1_t>(config, sink, pool);
+    case BULK_REGION_EU2:
+        return bulkEncode<PhyEu2_t>(config, sink, pool);
+    case BULK_REGION_US0:
+        return bulkEncode<PhyUs0_t, true>(config, sink, pool);
+    }
+    throw std::invalid_argument("unknown region");
+}
+
+} // namespace Host
+} // namespace TsUnbLib
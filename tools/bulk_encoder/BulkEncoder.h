@@ -0,0 +1,247 @@
+/**
+ * @file BulkEncoder.h
+ * @brief Multi-threaded host encoder for synthetic TS-UNB uplink traffic
+ * 
+ * Encodes packets of many virtual nodes with FixedUplinkMac, Phy and
+ * RadioBurst exactly as SimpleNode::send() does, without a transmitter.
+ * Node n uses the EUI-64 baseEui64 + n (the last two bytes are the short
+ * address) and sends packetsPerNode packets with consecutive packet
+ * counters. The payload is pseudo random, derived from the node and the
+ * packet counter, so the output does not depend on the number of threads.
+ * 
+ * The work is split into tasks of up to packetsPerTask packets of one node
+ * and distributed by a WorkStealingPool. Each worker owns its MAC (with its
+ * AES context and packet counter), PHY and output buffer; nothing is shared
+ * between the workers except the sink, which receives the output of one
+ * complete task at a time. The tasks are therefore written in completion
+ * order, the packets of a task in counter order.
+ * 
+ * Stream format, all values little endian:
+ *   header:  "TSUB", u8 version (1), u8 burst length in bytes,
+ *            u16 SYMBOL_RATE_MULT (T_RB unit is one symbol at this rate)
+ *   packet:  u8 eui64[8], u32 packet counter, u8 TSMA pattern,
+ *            u32 f_0 register value, u16 number of bursts, then per burst:
+ *            u16 carrier offset, u16 T_RB, u8 data[burst length]
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef TSUNB_BULK_ENCODER_H_
+#define TSUNB_BULK_ENCODER_H_
+
+#include "../../lib/ts-unb-lib-rfm69/TsUnb/RadioBurst.h"
+#include "../../lib/ts-unb-lib-rfm69/TsUnb/FixedMac.h"
+#include "../../lib/ts-unb-lib-rfm69/TsUnb/Phy.h"
+#include "WorkStealingPool.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace TsUnbLib {
+namespace Host {
+
+// Version of the stream format
+static const uint8_t BULK_STREAM_VERSION = 1;
+// Size of the stream header in bytes
+static const size_t BULK_STREAM_HEADER_LEN = 8;
+// Size of the packet record header in bytes (without the bursts)
+static const size_t BULK_PACKET_HEADER_LEN = 19;
+
+struct BulkEncodeConfig {
+    uint8_t baseEui64[8] = {0x70, 0xB3, 0xD5, 0x67, 0x70, 0x00, 0x00, 0x00};
+    uint8_t networkKey[16] = {0};
+    uint32_t numNodes = 1;
+    uint32_t packetsPerNode = 1;
+    uint32_t firstPacketCounter = 0;
+    uint16_t payloadLength = 10;
+    bool longAddress = false;
+    uint32_t packetsPerTask = 64;   // Granularity of the work stealing
+    unsigned numThreads = 0;        // 0: one per hardware thread
+};
+
+struct BulkEncodeStats {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;             // Including the stream header
+    uint64_t steals = 0;
+    double seconds = 0;
+};
+
+// Receives the stream, called by one thread at a time
+typedef std::function<void(const uint8_t* data, size_t length)> BulkSink;
+
+// EUI-64 of node nodeIdx, i.e. baseEui64 + nodeIdx as big endian number
+void bulkNodeEui64(const BulkEncodeConfig& config, uint32_t nodeIdx, uint8_t eui64[8]);
+
+// Pseudo random payload of a packet
+void bulkPayload(uint32_t nodeIdx, uint32_t packetCounter, uint8_t* payload, uint16_t length);
+
+// Appends a little endian value to the buffer
+template <typename T>
+static inline void bulkPut(std::vector<uint8_t>& out, T value) {
+    for (size_t i = 0; i < sizeof(T); i++) {
+        out.push_back((uint8_t)(value >> (8 * i)));
+    }
+}
+
+/**
+ * Per worker encoder state, the counterpart of SimpleNode without the transmitter
+ */
+template <class PHY, bool SYNC_BURST = false>
+class BulkPacketEncoder {
+public:
+    typedef typename PHY::RadioBurst_t RadioBurst_t;
+
+    explicit BulkPacketEncoder(const BulkEncodeConfig& config) : config(config) {
+        const uint8_t* k = config.networkKey;
+        mac.setNetworkKey(k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7],
+                          k[8], k[9], k[10], k[11], k[12], k[13], k[14], k[15]);
+        mac.setAddressMode(config.longAddress ? TsUnb::TsUnb_Long : TsUnb::TsUnb_Short);
+        mac.init();
+        // FixedUplinkMac::MPDU_Length() returns 8 bit, check the length before
+        const size_t mpduLength = MAC_OVERHEAD_SHORT_ADDR + config.payloadLength + (config.longAddress ? 6 : 0);
+        if (mpduLength > TSUNBPHY_MAX_PSDU_LENGTH) {
+            throw std::invalid_argument("payload too long for the TS-UNB PHY");
+        }
+        payload.resize(config.payloadLength);
+        mpdu.resize(mpduLength);
+        bursts.reset(new RadioBurst_t[phy.numRadioBursts(mpdu.size()) + 1]);
+    }
+
+    // Appends the packet records of count packets of node nodeIdx to out
+    void encode(uint32_t nodeIdx, uint32_t firstPacketCounter, uint32_t count, std::vector<uint8_t>& out) {
+        uint8_t eui64[8];
+        bulkNodeEui64(config, nodeIdx, eui64);
+        mac.setAddress(eui64[0], eui64[1], eui64[2], eui64[3], eui64[4], eui64[5], eui64[6], eui64[7]);
+        mac.extPkgCnt = firstPacketCounter;
+
+        for (uint32_t i = 0; i < count; i++) {
+            const uint32_t packetCounter = mac.extPkgCnt;
+            bulkPayload(nodeIdx, packetCounter, payload.data(), config.payloadLength);
+            const uint16_t mpduLength = mac.encode(mpdu.data(), payload.data(), config.payloadLength);
+
+            // Same order as SimpleNode::send(): the pattern of the incremented counter
+            const uint8_t tsmaPattern = mac.getTsmaPattern();
+            uint16_t numBursts = phy.numRadioBursts(mpduLength);
+            // Phy::encode() expects freshly constructed bursts, as the VLA in SimpleNode::send()
+            for (uint16_t b = 0; b < numBursts + (SYNC_BURST ? 1 : 0); b++) {
+                bursts[b] = RadioBurst_t();
+            }
+            RadioBurst_t* dataBursts = bursts.get();
+            if (SYNC_BURST) {
+                dataBursts++;
+            }
+            const uint32_t f0 = phy.encode(dataBursts, mpdu.data(), mpduLength, tsmaPattern);
+            if (SYNC_BURST) {
+                phy.encodeSyncBurst(&bursts[0], tsmaPattern, mac.shortAddr[1]);
+                numBursts++;
+            }
+
+            out.insert(out.end(), eui64, eui64 + 8);
+            bulkPut<uint32_t>(out, packetCounter);
+            bulkPut<uint8_t>(out, tsmaPattern);
+            bulkPut<uint32_t>(out, f0);
+            bulkPut<uint16_t>(out, numBursts);
+            for (uint16_t b = 0; b < numBursts; b++) {
+                const RadioBurst_t& burst = bursts[b];
+                bulkPut<uint16_t>(out, burst.getCarrierOffset());
+                bulkPut<uint16_t>(out, burst.get_T_RB());
+                out.insert(out.end(), burst.getBurst(), burst.getBurst() + burst.getBurstLengthBytes());
+            }
+        }
+    }
+
+private:
+    const BulkEncodeConfig& config;
+    TsUnb::FixedUplinkMac mac;     // Own AES context and packet counter
+    PHY phy;
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> mpdu;
+    std::unique_ptr<RadioBurst_t[]> bursts;
+};
+
+/**
+ * Encodes all packets of config into the sink
+ *
+ * @param SYMBOL_RATE_MULT  Symbol rate of the T_RB values, written into the stream header
+ */
+template <class PHY, bool SYNC_BURST = false, uint16_t SYMBOL_RATE_MULT = 48>
+BulkEncodeStats bulkEncode(const BulkEncodeConfig& config, const BulkSink& sink, WorkStealingPool& pool) {
+    typedef BulkPacketEncoder<PHY, SYNC_BURST> Encoder_t;
+
+    const uint32_t packetsPerTask = config.packetsPerTask != 0 ? config.packetsPerTask : 1;
+    const uint64_t tasksPerNode = (config.packetsPerNode + packetsPerTask - 1) / packetsPerTask;
+    const uint64_t numTasks = tasksPerNode * config.numNodes;
+
+    // Stream header
+    BulkEncodeStats stats;
+    std::vector<uint8_t> header = {'T', 'S', 'U', 'B', BULK_STREAM_VERSION,
+                                   (uint8_t)PHY::RadioBurst_t::BURST_LENGTH_BYTES};
+    bulkPut<uint16_t>(header, SYMBOL_RATE_MULT);
+    sink(header.data(), header.size());
+    stats.bytes = header.size();
+
+    struct Worker {
+        explicit Worker(const BulkEncodeConfig& config) : encoder(config) {}
+        Encoder_t encoder;
+        std::vector<uint8_t> buffer;
+        uint64_t packets = 0;
+        uint64_t bytes = 0;
+    };
+    std::vector<std::unique_ptr<Worker> > workers;
+    for (unsigned i = 0; i < pool.size(); i++) {
+        workers.emplace_back(new Worker(config));
+    }
+
+    std::mutex sinkMutex;
+    const auto start = std::chrono::steady_clock::now();
+    pool.run(numTasks, [&](unsigned workerIdx, uint64_t task) {
+        Worker& worker = *workers[workerIdx];
+        const uint32_t nodeIdx = (uint32_t)(task / tasksPerNode);
+        const uint32_t first = (uint32_t)(task % tasksPerNode) * packetsPerTask;
+        const uint32_t count = config.packetsPerNode - first < packetsPerTask ?
+                               config.packetsPerNode - first : packetsPerTask;
+
+        worker.buffer.clear();
+        worker.encoder.encode(nodeIdx, config.firstPacketCounter + first, count, worker.buffer);
+        worker.packets += count;
+        worker.bytes += worker.buffer.size();
+
+        std::lock_guard<std::mutex> lock(sinkMutex);
+        sink(worker.buffer.data(), worker.buffer.size());
+    });
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (const auto& worker : workers) {
+        stats.packets += worker->packets;
+        stats.bytes += worker->bytes;
+    }
+    stats.steals = pool.steals();
+    return stats;
+}
+
+// PHY configurations of HostTsUnb.h, i.e. RPPicoTsUnbTemplates.h without fixed MPDU length
+enum BulkRegion {
+    BULK_REGION_EU0,
+    BULK_REGION_EU1,
+    BULK_REGION_EU2,
+    BULK_REGION_US0,
+};
+
+// Returns false for an unknown region name ("eu0", "eu1", "eu2" or "us0")
+bool bulkParseRegion(const char* name, BulkRegion& region);
+
+// bulkEncode() for the PHY of the region
+BulkEncodeStats bulkEncodeRegion(BulkRegion region, const BulkEncodeConfig& config,
+                                 const BulkSink& sink, WorkStealingPool& pool);
+
+} // namespace Host
+} // namespace TsUnbLib
+
+#endif // TSUNB_BULK_ENCODER_H_
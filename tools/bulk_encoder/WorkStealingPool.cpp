@@ -0,0 +1,152 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Work-stealing thread pool of the host bulk encoder
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "WorkStealingPool.h"
+
+namespace TsUnbLib {
+namespace Host {
+
+WorkStealingPool::WorkStealingPool(unsigned numWorkers)
+    : numWorkers(numWorkers != 0 ? numWorkers :
+                 (std::thread::hardware_concurrency() != 0 ? std::thread::hardware_concurrency() : 1)),
+      ranges(new TaskRange[this->numWorkers]) {
+    // Worker 0 is the thread calling run()
+    for (unsigned i = 1; i < this->numWorkers; i++) {
+        threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCv.notify_all();
+    for (std::thread& t : threads) {
+        t.join();
+    }
+}
+
+void WorkStealingPool::run(uint64_t numTasks, const TaskFn& fn) {
+    // Contiguous start ranges, the first numTasks % numWorkers workers get one task more
+    const uint64_t perWorker = numTasks / numWorkers;
+    const uint64_t remainder = numTasks % numWorkers;
+    uint64_t begin = 0;
+    for (unsigned i = 0; i < numWorkers; i++) {
+        const uint64_t len = perWorker + (i < remainder ? 1 : 0);
+        std::lock_guard<std::mutex> lock(ranges[i].mutex);
+        ranges[i].begin = begin;
+        ranges[i].end = begin + len;
+        begin += len;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        error = nullptr;
+        failed = false;
+        numSteals = 0;
+        busyWorkers = numWorkers - 1;
+        generation++;
+    }
+    startCv.notify_all();
+
+    runTasks(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCv.wait(lock, [this] { return busyWorkers == 0; });
+    job = nullptr;
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void WorkStealingPool::workerLoop(unsigned worker) {
+    uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCv.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runTasks(worker);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busyWorkers--;
+        }
+        doneCv.notify_one();
+    }
+}
+
+void WorkStealingPool::runTasks(unsigned worker) {
+    uint64_t task;
+    while (popLocal(worker, task) || steal(worker, task)) {
+        try {
+            (*job)(worker, task);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!failed) {
+                failed = true;
+                error = std::current_exception();
+            }
+        }
+
+        if (failed) {
+            // Drop the own tasks, the other workers do the same
+            std::lock_guard<std::mutex> lock(ranges[worker].mutex);
+            ranges[worker].begin = ranges[worker].end;
+            return;
+        }
+    }
+}
+
+bool WorkStealingPool::popLocal(unsigned worker, uint64_t& task) {
+    TaskRange& range = ranges[worker];
+    std::lock_guard<std::mutex> lock(range.mutex);
+    if (range.begin == range.end) {
+        return false;
+    }
+    task = range.begin++;
+    return true;
+}
+
+bool WorkStealingPool::steal(unsigned worker, uint64_t& task) {
+    for (unsigned i = 1; i < numWorkers; i++) {
+        TaskRange& victim = ranges[(worker + i) % numWorkers];
+        uint64_t begin, end;
+        {
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            const uint64_t left = victim.end - victim.begin;
+            if (left == 0) {
+                continue;
+            }
+            // Take the back half, the victim keeps working on the front
+            begin = victim.end - (left + 1) / 2;
+            end = victim.end;
+            victim.end = begin;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(ranges[worker].mutex);
+            ranges[worker].begin = begin + 1;
+            ranges[worker].end = end;
+        }
+        numSteals++;
+        task = begin;
+        return true;
+    }
+    return false;
+}
+
+} // namespace Host
+} // namespace TsUnbLib
@@ -0,0 +1,83 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Work-stealing thread pool of the host bulk encoder
+ * 
+ * The tasks of a job are numbered 0..numTasks-1. Each worker starts with a
+ * contiguous range of task indices and takes tasks from the front of it.
+ * A worker without tasks steals the back half of the range of another
+ * worker, so large ranges are split only when a worker runs out of work.
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#ifndef TSUNB_WORK_STEALING_POOL_H_
+#define TSUNB_WORK_STEALING_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TsUnbLib {
+namespace Host {
+
+class WorkStealingPool {
+public:
+    // Task function, called with the index of the worker (0..size()-1) and the task index
+    typedef std::function<void(unsigned worker, uint64_t task)> TaskFn;
+
+    // Starts numWorkers threads, 0 uses std::thread::hardware_concurrency()
+    explicit WorkStealingPool(unsigned numWorkers = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return numWorkers; }
+
+    // Runs all tasks and returns when they are done. Rethrows the first
+    // exception thrown by a task, the remaining tasks are skipped then.
+    void run(uint64_t numTasks, const TaskFn& fn);
+
+    // Number of successful steals during the last run()
+    uint64_t steals() const { return numSteals; }
+
+private:
+    // Remaining task indices [begin, end) of a worker, own cache line
+    struct alignas(64) TaskRange {
+        std::mutex mutex;
+        uint64_t begin = 0;
+        uint64_t end = 0;
+    };
+
+    void workerLoop(unsigned worker);
+    void runTasks(unsigned worker);
+    bool popLocal(unsigned worker, uint64_t& task);
+    bool steal(unsigned worker, uint64_t& task);
+
+    const unsigned numWorkers;
+    std::unique_ptr<TaskRange[]> ranges;
+    std::vector<std::thread> threads;
+
+    std::mutex mutex;
+    std::condition_variable startCv;
+    std::condition_variable doneCv;
+    uint64_t generation = 0;
+    unsigned busyWorkers = 0;
+    bool stopping = false;
+    const TaskFn* job = nullptr;
+    std::exception_ptr error;
+    std::atomic<bool> failed{false};
+    std::atomic<uint64_t> numSteals{0};
+};
+
+} // namespace Host
+} // namespace TsUnbLib
+
+#endif // TSUNB_WORK_STEALING_POOL_H_
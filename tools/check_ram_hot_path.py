@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+@file check_ram_hot_path.py
+@brief Checks that the TS-UNB transmit hot path does not call code in flash
+
+The functions executed while the TS-UNB symbol timer is running are placed in
+SRAM (TSUNB_TX_IN_RAM). This script disassembles the linked firmware, follows
+all direct calls and tail calls starting at the hot path roots and fails if
+one of them ends in flash (XIP), either directly or through a linker veneer.
+Calls through registers cannot be followed and are only reported.
+
+Usage: check_ram_hot_path.py [--objdump arm-none-eabi-objdump] firmware.elf
+
+Copyright (c) 2025 mioty Alliance e.V.
+SPDX-License-Identifier: MIT
+"""
+
+import argparse
+import re
+import subprocess
+import sys
+
+# RP2040 memory map: boot ROM below the XIP window, XIP (flash) incl. its aliases, SRAM above
+XIP_BASE = 0x10000000
+SRAM_BASE = 0x20000000
+
+# Hot path entry points: the burst loop of the transmitter, the symbol timer callback and the
+# SDK alarm interrupt which calls it (alarm pool of SDK 2.x, hardware alarm of SDK 1.x). The
+# callback is called through a pointer, so the interrupt handler is a root of its own.
+TSUNB_ROOTS = [r"transmitBursts", r"timer_callback"]
+SDK_ROOTS = [r"^alarm_pool_irq_handler$", r"^hardware_alarm_irq_handler$", r"^alarm_pool_alarm_callback$"]
+DEFAULT_ROOTS = TSUNB_ROOTS + SDK_ROOTS
+
+FUNC_RE = re.compile(r"^([0-9a-f]+) <(.+)>:$")
+CALL_RE = re.compile(r"^\s*([0-9a-f]+):\s+(bl|blx|b|b\.n|b\.w|call|jmp)\s+([0-9a-f]+) <([^>+]+)(\+0x[0-9a-f]+)?>")
+INDIRECT_RE = re.compile(r"^\s*([0-9a-f]+):\s+(blx|call)\s+(r\d+|lr|ip|\*%\w+)")
+VENEER_RE = re.compile(r"^__(.+)_veneer$")
+
+
+def in_flash(addr):
+    return XIP_BASE <= addr < SRAM_BASE
+
+
+def disassemble(objdump, elf):
+    """Returns {name: (address, [(callee name, callee address)], indirect calls)}"""
+    out = subprocess.run([objdump, "-d", "--no-show-raw-insn", elf],
+                         check=True, capture_output=True, text=True).stdout
+    functions = {}
+    current = None
+    for line in out.splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            current = m.group(2)
+            functions[current] = [int(m.group(1), 16), [], 0]
+            continue
+        if current is None:
+            continue
+        m = CALL_RE.match(line)
+        if m:
+            # Branches to an offset are jumps inside a function, not calls
+            if m.group(5) is None and m.group(4) != current:
+                functions[current][1].append((m.group(4), int(m.group(3), 16)))
+            continue
+        if INDIRECT_RE.match(line):
+            functions[current][2] += 1
+    return functions
+
+
+def demangle(names):
+    try:
+        out = subprocess.run(["c++filt"], input="\n".join(names), check=True,
+                             capture_output=True, text=True).stdout.splitlines()
+        return dict(zip(names, out))
+    except (OSError, subprocess.CalledProcessError):
+        return {n: n for n in names}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[2])
+    parser.add_argument("elf")
+    parser.add_argument("--objdump", default="arm-none-eabi-objdump")
+    parser.add_argument("--root", action="append", help="regular expression of a hot path entry point")
+    args = parser.parse_args()
+
+    functions = disassemble(args.objdump, args.elf)
+    root_patterns = [re.compile(r) for r in (args.root or DEFAULT_ROOTS)]
+    roots = [n for n in functions if any(p.search(n) for p in root_patterns)]
+
+    if not roots:
+        print("error: no TS-UNB hot path entry point found (%s)"
+              % ", ".join(p.pattern for p in root_patterns), file=sys.stderr)
+        return 1
+    if args.root is None and not any(re.search(r, n) for r in SDK_ROOTS for n in roots):
+        print("warning: SDK alarm interrupt handler not found, only the TS-UNB functions are checked",
+              file=sys.stderr)
+
+    # Breadth first search over the call graph, remembering the caller for the report
+    parent = {r: None for r in roots}
+    queue = list(roots)
+    errors = []
+    indirect = 0
+    while queue:
+        name = queue.pop(0)
+        addr, callees, num_indirect = functions[name]
+        indirect += num_indirect
+        if in_flash(addr):
+            errors.append(name)
+            continue
+        for callee, callee_addr in callees:
+            veneer = VENEER_RE.match(callee)
+            if veneer and veneer.group(1) in functions:
+                callee = veneer.group(1)
+                callee_addr = functions[callee][0]
+            if callee in parent:
+                continue
+            parent[callee] = name
+            if callee in functions:
+                queue.append(callee)
+            elif in_flash(callee_addr):
+                errors.append(callee)
+
+    names = demangle(list(parent.keys()))
+    if errors:
+        print("error: TS-UNB transmit hot path calls code in flash:", file=sys.stderr)
+        for name in errors:
+            chain = []
+            while name is not None:
+                chain.append(names.get(name, name))
+                name = parent[name]
+            print("  " + "\n    <- ".join(chain), file=sys.stderr)
+        return 1
+
+    print("TS-UNB transmit hot path: %d functions in SRAM/ROM, %d indirect calls not followed"
+          % (len(parent), indirect))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
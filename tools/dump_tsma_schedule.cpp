@@ -0,0 +1,50 @@
+/**
+ * @file dump_tsma_schedule.cpp
+ * @brief Host tool to dump the precomputed TSMA schedules of the TS-UNB PHY
+ * 
+ * Prints the core frame schedules that Phy::addTsmaPattern() applies for
+ * all uplink pattern groups as CSV, so they can be checked against the
+ * tables in ETSI TS 103 357 (6.4.7.1.6.1). Pattern numbers are printed
+ * as in the standard, i.e. starting with 1.
+ * 
+ * Build: g++ -std=c++17 -O2 -o dump_tsma_schedule tools/dump_tsma_schedule.cpp
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "../lib/ts-unb-lib-rfm69/TsUnb/RadioBurst.h"
+#include "../lib/ts-unb-lib-rfm69/TsUnb/Phy.h"
+#include <cstdio>
+
+using namespace TsUnbLib::TsUnb;
+
+// Carrier spacings B_c of the configurations in RPPicoTsUnbTemplates.h (EU0/EU1 and EU2/US0)
+template <TsUnbUPGMode UPG, uint32_t B_c>
+using Phy_t = Phy<14224261, 14224261, B_c, 39, UPG>;
+
+template <class PHY>
+static void dumpSchedule(const char* upgName, uint32_t B_c) {
+    for (uint8_t p = 0; p < PHY::NUM_TSMA_PATTERNS; p++) {
+        const typename PHY::TsmaSchedule& schedule = PHY::getTsmaSchedule(p);
+        for (uint16_t i = 0; i < TSUNBPHY_NUM_CORE_BURSTS; i++) {
+            printf("%s,%u,%u,%u,%u,%u,%u\n", upgName, (unsigned)B_c, p + 1, i,
+                   schedule.burst[i].carrierOffset / B_c,
+                   schedule.burst[i].carrierOffset,
+                   schedule.burst[i].T_RB);
+        }
+    }
+}
+
+int main() {
+    printf("upg,b_c,pattern,burst,c_rb,carrier_offset,t_rb\n");
+
+    dumpSchedule<Phy_t<TsUnb_UPG1, 39> >("UPG1", 39);
+    dumpSchedule<Phy_t<TsUnb_UPG2, 39> >("UPG2", 39);
+    dumpSchedule<Phy_t<TsUnb_UPG3, 39> >("UPG3", 39);
+    dumpSchedule<Phy_t<TsUnb_UPG1, 468> >("UPG1", 468);
+    dumpSchedule<Phy_t<TsUnb_UPG2, 468> >("UPG2", 468);
+    dumpSchedule<Phy_t<TsUnb_UPG3, 468> >("UPG3", 468);
+
+    return 0;
+}
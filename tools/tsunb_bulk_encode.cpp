@@ -0,0 +1,164 @@
+/**
+ * @file tsunb_bulk_encode.cpp
+ * @brief Host tool to generate synthetic TS-UNB uplink traffic
+ * 
+ * Encodes the packets of many virtual nodes with the multi-threaded bulk
+ * encoder (bulk_encoder/BulkEncoder.h) and writes the radio bursts with
+ * their timing into a binary stream, e.g. for load tests of base stations.
+ * Without --out the stream is discarded and only the throughput is shown.
+ * 
+ * Built with -DTSUNB_HOST_BUILD=ON, run: ./tsunb_bulk_encode --help
+ * 
+ * Copyright (c) 2025 mioty Alliance e.V.
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "bulk_encoder/BulkEncoder.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+using namespace TsUnbLib::Host;
+
+static void usage(const char* name) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --region eu0|eu1|eu2|us0   PHY configuration (default eu1)\n"
+            "  --nodes N                  Number of virtual nodes (default 1000)\n"
+            "  --packets N                Packets per node (default 100)\n"
+            "  --payload N                MAC payload length in bytes (default 10)\n"
+            "  --counter N                Packet counter of the first packet (default 0)\n"
+            "  --eui HEX16                EUI-64 of node 0 (default 70B3D56770000000)\n"
+            "  --key HEX32                Network key (default all zero)\n"
+            "  --long                     Long (EUI-64) instead of short addressing\n"
+            "  --threads N                Worker threads, 0 for all cores (default 0)\n"
+            "  --task N                   Packets per work-stealing task (default 64)\n"
+            "  --out FILE                 Write the stream to FILE, - for stdout\n"
+            "  --scaling                  Measure the throughput for 1..threads workers\n",
+            name);
+}
+
+static bool parseHex(const char* text, uint8_t* out, size_t len) {
+    if (strlen(text) != 2 * len) {
+        return false;
+    }
+    for (size_t i = 0; i < len; i++) {
+        char byte[3] = {text[2 * i], text[2 * i + 1], 0};
+        char* end;
+        out[i] = (uint8_t)strtoul(byte, &end, 16);
+        if (*end != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void report(unsigned threads, const BulkEncodeStats& stats, double baseRate) {
+    const double rate = stats.packets / stats.seconds;
+    fprintf(stderr, "  %3u threads  %10llu packets  %8.3f s  %12.0f packets/s  %5.2fx  %6llu steals\n",
+            threads, (unsigned long long)stats.packets, stats.seconds, rate,
+            baseRate > 0 ? rate / baseRate : 1.0, (unsigned long long)stats.steals);
+}
+
+int main(int argc, char** argv) {
+    BulkEncodeConfig config;
+    config.numNodes = 1000;
+    config.packetsPerNode = 100;
+    BulkRegion region = BULK_REGION_EU1;
+    const char* outName = nullptr;
+    bool scaling = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* opt = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        bool ok = true;
+        if (strcmp(opt, "--long") == 0) {
+            config.longAddress = true;
+            continue;
+        } else if (strcmp(opt, "--scaling") == 0) {
+            scaling = true;
+            continue;
+        } else if (value == nullptr) {
+            ok = false;
+        } else if (strcmp(opt, "--region") == 0) {
+            ok = bulkParseRegion(value, region);
+        } else if (strcmp(opt, "--nodes") == 0) {
+            config.numNodes = strtoul(value, nullptr, 0);
+        } else if (strcmp(opt, "--packets") == 0) {
+            config.packetsPerNode = strtoul(value, nullptr, 0);
+        } else if (strcmp(opt, "--payload") == 0) {
+            config.payloadLength = (uint16_t)strtoul(value, nullptr, 0);
+        } else if (strcmp(opt, "--counter") == 0) {
+            config.firstPacketCounter = strtoul(value, nullptr, 0);
+        } else if (strcmp(opt, "--eui") == 0) {
+            ok = parseHex(value, config.baseEui64, sizeof(config.baseEui64));
+        } else if (strcmp(opt, "--key") == 0) {
+            ok = parseHex(value, config.networkKey, sizeof(config.networkKey));
+        } else if (strcmp(opt, "--threads") == 0) {
+            config.numThreads = strtoul(value, nullptr, 0);
+        } else if (strcmp(opt, "--task") == 0) {
+            config.packetsPerTask = strtoul(value, nullptr, 0);
+        } else if (strcmp(opt, "--out") == 0) {
+            outName = value;
+        } else {
+            ok = false;
+        }
+        if (!ok) {
+            usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    try {
+        if (scaling) {
+            // Throughput without output for 1, 2, 4, ... workers
+            WorkStealingPool maxPool(config.numThreads);
+            const unsigned maxThreads = maxPool.size();
+            const BulkSink discard = [](const uint8_t*, size_t) {};
+            fprintf(stderr, "Bulk encoder scaling (%u nodes x %u packets, payload %u bytes)\n",
+                    config.numNodes, config.packetsPerNode, config.payloadLength);
+            double baseRate = 0;
+            for (unsigned threads = 1;; threads = threads * 2 < maxThreads ? threads * 2 : maxThreads) {
+                WorkStealingPool pool(threads);
+                const BulkEncodeStats stats = bulkEncodeRegion(region, config, discard, pool);
+                if (baseRate == 0) {
+                    baseRate = stats.packets / stats.seconds;
+                }
+                report(threads, stats, baseRate);
+                if (threads == maxThreads) {
+                    break;
+                }
+            }
+            return 0;
+        }
+
+        FILE* out = nullptr;
+        if (outName != nullptr) {
+            out = strcmp(outName, "-") == 0 ? stdout : fopen(outName, "wb");
+            if (out == nullptr) {
+                fprintf(stderr, "Cannot open %s\n", outName);
+                return 1;
+            }
+        }
+        const BulkSink sink = [out](const uint8_t* data, size_t length) {
+            if (out != nullptr && fwrite(data, 1, length, out) != length) {
+                throw std::runtime_error("write error");
+            }
+        };
+
+        WorkStealingPool pool(config.numThreads);
+        const BulkEncodeStats stats = bulkEncodeRegion(region, config, sink, pool);
+        if (out != nullptr && out != stdout) {
+            fclose(out);
+        }
+        fprintf(stderr, "Encoded %llu packets, %llu bytes\n",
+                (unsigned long long)stats.packets, (unsigned long long)stats.bytes);
+        report(pool.size(), stats, 0);
+    } catch (const std::exception& e) {
+        fprintf(stderr, "Error: %s\n", e.what());
+        return 1;
+    }
+    return 0;
+}